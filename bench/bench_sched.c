@@ -0,0 +1,236 @@
+/** @file
+ *	@brief	Host benchmark of the multi-threaded scheduler: throughput from 1 worker up to N.
+ *
+ *	Every instance of a pool starts with one event; its handler does a fixed amount of work, then
+ *	posts the instance its next event, until each instance has run its share. The workers generate
+ *	the whole load, so no producer thread limits it. Prints one CSV line per worker count:
+ *
+ *		name,workers,instances,ns_per_event,events_per_s,speedup
+ *
+ *	- `workers`: worker threads; 1, 2, 4, ... up to N, and N itself;
+ *	- `instances`: instances in the pool;
+ *	- `ns_per_event`: mean wall-clock time per event run, in nanoseconds;
+ *	- `events_per_s`: the same, as a rate;
+ *	- `speedup`: events_per_s over that of 1 worker.
+ *
+ *	Usage: `bench_sched [--quick] [N]`. N defaults to the number of online processors. With
+ *	`--quick`, each instance runs 1% of its usual events, as a smoke test; the figures are then too
+ *	noisy to compare.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE	200112L	/* clock_gettime(), sysconf() */
+#endif
+#include <stdio.h>
+#include <stdlib.h>		/* strtoul() */
+#include <string.h>
+#include <time.h>
+#include <unistd.h>		/* sysconf() */
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme_sched.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/** Instances in the pool, and events each runs. */
+#define INSTANCES			(4096)
+#define EVENTS_PER_INST		(2000)
+
+/** Rounds of work each handler does per event: roughly 100 ns, in the range of a real handler. */
+#define WORK_ROUNDS			(64)
+
+/** Capacity of each instance's inbox; an instance never has more than one event pending. */
+#define SZINBOX				(4)
+
+/** Most workers measured. */
+#define MAXWORKERS			(256)
+
+enum { evWork = 1 };
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/** Each instance's application data. */
+typedef struct sBenchInst {
+	uint32_t	remaining;		// events still to run
+	uint32_t	acc;			// what the work computes
+} tBenchInst;
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+/** Divisor of every event count; 100 with `--quick`. */
+static uint32_t				opsdivisor = 1;
+
+static pfStateHandler		states[INSTANCES];
+static tStateReturnCodes	phases[INSTANCES];
+static tCwswClockTics		timers[INSTANCES];
+static tEvQ_EventID			evids[INSTANCES];
+static tBenchInst			user[INSTANCES];
+static tSmePool				pool;
+static ptSmeSched			pSched;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+static uint64_t
+NowNs(void)
+{
+	struct timespec ts;
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+/** Does the event's work, then posts the instance its next event. */
+static tStateReturnCodes
+Chain(ptSmeInstCtx pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	tBenchInst *pInst = (tBenchInst *)SME_INST_USER(pctx);
+	uint32_t acc = pInst->acc ^ pev->evData;
+	uint32_t round;
+
+	(void)pextra;
+	for(round = 0; round < WORK_ROUNDS; ++round)
+	{
+		acc = (acc * 1103515245u) + 12345u;
+	}
+	pInst->acc = acc;
+	if(--pInst->remaining)
+	{
+		(void)Cwsw_Sme_Sched_Post(pSched, pctx->inst, *pev, 0);
+	}
+	SME_INST_PHASE(pctx) = kStateOperational;
+	return kStateOperational;
+}
+
+static tTransitionTable	tbl[] = {
+	{ SME_INST_STATE(Chain), 0, 0, 0, SME_INST_STATE(Chain), NULL, NULL, kSmeMatch_StateOnly },
+};
+
+/** Run every instance's events on `workers` threads.
+ *	@returns Events per second; 0 if the scheduler could not be created or lost events.
+ */
+static double
+BenchWorkers(uint32_t workers, double base)
+{
+	tSmePool p = {
+		/* .pTbl = */		tbl,
+		/* .szTbl = */		1,
+		/* .pIndex = */		NULL,
+		/* .capacity = */	INSTANCES,
+		/* .count = */		0,
+		/* .pState = */		states,
+		/* .pPhase = */		phases,
+		/* .pTimer = */		timers,
+		/* .pEvId = */		evids,
+		/* .pUser = */		(uint8_t *)user,
+		/* .szUser = */		sizeof(tBenchInst),
+		/* .maxchain = */	0,
+		/* .pInterest = */	NULL,
+		/* .pHsm = */		NULL,
+		/* .pWheel = */		NULL,
+		/* .pEntered = */	NULL
+	};
+	uint64_t events = (uint64_t)INSTANCES * (EVENTS_PER_INST / opsdivisor);
+	tEvQ_Event ev = { evWork, 0 };
+	tSmeSchedStats stats;
+	tSmeInstance inst;
+	uint64_t start, ns;
+	double nsperevent, persec;
+
+	pool = p;
+	if(!Cwsw_Sme_Pool_Init(&pool))	{ return 0.0; }
+	for(inst = 0; inst < INSTANCES; ++inst)
+	{
+		(void)Cwsw_Sme_Pool_Add(&pool, SME_INST_STATE(Chain));
+		user[inst].remaining = EVENTS_PER_INST / opsdivisor;
+		user[inst].acc = inst;
+	}
+	pSched = Cwsw_Sme_Sched_Create(&pool, workers, SZINBOX);
+	if(!pSched)						{ return 0.0; }
+
+	start = NowNs();
+	for(inst = 0; inst < INSTANCES; ++inst)
+	{
+		ev.evData = inst;
+		(void)Cwsw_Sme_Sched_Post(pSched, inst, ev, 0);
+	}
+	Cwsw_Sme_Sched_Drain(pSched);
+	ns = NowNs() - start;
+	Cwsw_Sme_Sched_Stats(pSched, &stats);
+	Cwsw_Sme_Sched_Destroy(pSched);
+	if(stats.events != events)		{ return 0.0; }
+
+	nsperevent = (double)ns / (double)events;
+	persec = (nsperevent > 0.0) ? (1e9 / nsperevent) : 0.0;
+	printf("sched_chain,%u,%u,%.2f,%.0f,%.2f\n", workers, INSTANCES, nsperevent, persec,
+		(base > 0.0) ? (persec / base) : 1.0);
+	return persec;
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(int argc, char *argv[])
+{
+	long online = sysconf(_SC_NPROCESSORS_ONLN);
+	uint32_t maxworkers = (online > 0) ? (uint32_t)online : 1;
+	uint32_t workers;
+	double base = 0.0;
+	double persec;
+	int arg;
+
+	for(arg = 1; arg < argc; ++arg)
+	{
+		if(strcmp(argv[arg], "--quick") == 0)
+		{
+			opsdivisor = 100;
+		}
+		else if((maxworkers = (uint32_t)strtoul(argv[arg], NULL, 10)) == 0)
+		{
+			fprintf(stderr, "usage: %s [--quick] [N]\n", argv[0]);
+			return 2;
+		}
+	}
+	if(maxworkers > MAXWORKERS)	{ maxworkers = MAXWORKERS; }
+
+	printf("name,workers,instances,ns_per_event,events_per_s,speedup\n");
+	for(workers = 1; ; workers *= 2)
+	{
+		if(workers > maxworkers)	{ workers = maxworkers; }
+		persec = BenchWorkers(workers, base);
+		if(persec <= 0.0)
+		{
+			fprintf(stderr, "%s: run with %u workers failed\n", argv[0], workers);
+			return 1;
+		}
+		if(workers == 1)			{ base = persec; }
+		if(workers == maxworkers)	{ break; }
+	}
+	return 0;
+}
@@ -0,0 +1,385 @@
+/** @file
+ *	@brief	Host benchmark of the SME hot paths.
+ *
+ *	Measures what the design notes list under "Measuring the SME hot paths", and prints one CSV
+ *	line per result:
+ *
+ *		name,rows,position,ns_per_op,events_per_s
+ *
+ *	- `name`: the path measured;
+ *	- `rows`: size in rows of the transition table searched;
+ *	- `position`: for the lookups, where the matching row is (`first`, `last`, `miss`); otherwise `-`;
+ *	- `ns_per_op`: mean time per lookup or SME step, in nanoseconds;
+ *	- `events_per_s`: the same, as a rate.
+ *
+ *	Usage: `bench_sme [--quick]`. With `--quick`, every measurement runs 1% of its usual count, as a
+ *	smoke test; the figures are then too noisy to compare.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE	199309L	/* clock_gettime() */
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/** Largest table measured. */
+#define MAXROWS				(4096)
+
+/** States in a kShape_States table. */
+#define LOOKUP_STATES		(4)
+
+/** Lookups timed for each table size and position: about this many rows visited in all. */
+#define LOOKUP_WORK			(200000000ull)
+
+/** SME steps timed for each of the step measurements. */
+#define STEP_OPS			(20000000ull)
+
+/** Each measurement is split into this many runs, and the fastest is reported: on a shared host,
+ *	the least disturbed.
+ */
+#define REPEATS				(5)
+
+/** The stoplight's tick period, in tics, and the tics between "go" button presses. */
+#define STOPLIGHT_TICK		(20)
+#define STOPLIGHT_GO		(1370)
+
+/** Ticks each light stays lit, unless "go" cuts it short. */
+#define STOPLIGHT_RED		(30)
+#define STOPLIGHT_GREEN		(25)
+#define STOPLIGHT_YELLOW	(5)
+
+enum { evTick = 1, evGo = 2, evTimeout = 3 };
+enum { kRed = 1, kGreen = 2, kYellow = 3 };
+
+/** Shapes of the tables searched by the lookup measurements. */
+typedef enum eTableShape {
+	kShape_Keyed,		// every row compares reason1 and reason3: the index can key every row
+	kShape_Guarded,		// every row compares only reason1, and has a guard: no row can be keyed
+	kShape_States		// as kShape_Keyed, but the rows are dealt out to LOOKUP_STATES states in turn
+} tTableShape;
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+/** Divisor of every operation count; 100 with `--quick`. */
+static uint64_t				opsdivisor = 1;
+
+/** Everything measured is folded in here, so the compiler can't discard any of it. */
+static volatile uintptr_t	sink;
+
+static tTransitionTable		tbl[MAXROWS];
+static tSmeIndexKey			keys[MAXROWS];
+static uint32_t				columns[SME_SOA_COLUMNS * MAXROWS];
+static tSmePackedRow		packedrows[MAXROWS];
+static uint16_t				packedfirst[LOOKUP_STATES + 2];	// one per state in lookupstates, plus 1
+
+/* the stoplight's states keep their phase and timer as the template's states do. */
+static tStateReturnCodes	redphase, greenphase, yellowphase;
+static int32_t				redtimer, greentimer, yellowtimer;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+static uint64_t
+NowNs(void)
+{
+	struct timespec ts;
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+static void
+Report(char const *name, uint32_t rows, char const *position, uint64_t ops, uint64_t ns)
+{
+	double nsperop = (ops > 0) ? ((double)ns / (double)ops) : 0.0;
+	double persec = (nsperop > 0.0) ? (1e9 / nsperop) : 0.0;
+	printf("%s,%u,%s,%.2f,%.0f\n", name, rows, position, nsperop, persec);
+}
+
+/** Time `ops` evaluations of `expr`, in REPEATS runs, and report the fastest run. */
+#define MEASURE(name, rows, position, ops, expr)	do {	\
+	uint64_t measureops = ((ops) + REPEATS - 1) / REPEATS;	\
+	uint64_t measurebest = UINT64_MAX;						\
+	uint64_t measureidx;									\
+	int measurerun;											\
+	for(measurerun = 0; measurerun < REPEATS; ++measurerun)	\
+	{														\
+		uint64_t measurestart = NowNs();					\
+		for(measureidx = 0; measureidx < measureops; ++measureidx)	\
+		{													\
+			expr;											\
+		}													\
+		measurestart = NowNs() - measurestart;				\
+		if(measurestart < measurebest)	{ measurebest = measurestart; }	\
+	}														\
+	Report(name, rows, position, measureops, measurebest);	\
+} while(0)
+
+static uint64_t
+Ops(uint64_t ops)
+{
+	ops /= opsdivisor;
+	return (ops > 0) ? ops : 1;
+}
+
+/* the lookup tables' states are only compared, never called. */
+static tStateReturnCodes S0(ptEvQ_Event pev, uint32_t *pextra)	{ (void)pev; (void)pextra; return kStateOperational; }
+static tStateReturnCodes S1(ptEvQ_Event pev, uint32_t *pextra)	{ (void)pev; (void)pextra; return kStateOperational; }
+static tStateReturnCodes S2(ptEvQ_Event pev, uint32_t *pextra)	{ (void)pev; (void)pextra; return kStateOperational; }
+static tStateReturnCodes S3(ptEvQ_Event pev, uint32_t *pextra)	{ (void)pev; (void)pextra; return kStateOperational; }
+
+static bool Pass(tEvQ_Event ev, uint32_t extra)	{ (void)ev; (void)extra; return true; }
+
+/* after NULL, the LOOKUP_STATES current states of a kShape_States table. */
+static pfStateHandler const			lookupstates[LOOKUP_STATES + 1] = { NULL, S0, S1, S2, S3 };
+static ptEvQ_EvHandlerFunc const	lookuptransitions[] = { NULL };
+static pfSmeGuard const				lookupguards[] = { NULL, Pass };
+
+/** Index in lookupstates of the current state of row `row`. */
+static uint8_t
+LookupState(uint32_t row, tTableShape shape)
+{
+	return (uint8_t)(1 + ((shape == kShape_States) ? (row % LOOKUP_STATES) : 0));
+}
+
+/** Build a table of `rows` rows, for state S0 or, in a kShape_States table, for each state in turn;
+ *	row `n` is selected by event ID `n + 1`.
+ */
+static void
+BuildLookupTable(uint32_t rows, tTableShape shape)
+{
+	uint32_t row;
+
+	for(row = 0; row < rows; ++row)
+	{
+		tbl[row].pfCurrent		= lookupstates[LookupState(row, shape)];
+		tbl[row].reason1		= row + 1;
+		tbl[row].reason2		= 0;
+		tbl[row].reason3		= 0;
+		tbl[row].pfNext			= S1;
+		tbl[row].pfTransition	= NULL;
+		tbl[row].pfGuard		= (shape == kShape_Guarded) ? Pass : NULL;
+		tbl[row].match			= (shape == kShape_Guarded) ? (uint8_t)kSmeMatch_Reason1 : (uint8_t)kSmeMatch_Default;
+	}
+}
+
+/** Time every lookup at one table size and shape. */
+static void
+BenchLookups(uint32_t rows, tTableShape shape)
+{
+	static char const * const positions[] = { "first", "last", "miss" };
+	char const *suffix = (shape == kShape_Guarded) ? "_guarded" : (shape == kShape_States) ? "_states" : "";
+	tSmeTransitionIndex index;
+	tSmeSoaTable soa;
+	tSmePackedTable packed;
+	uint32_t pos;
+	char name[48];
+
+	BuildLookupTable(rows, shape);
+	if(		!Cwsw_Sme_CompileTable(&index, tbl, rows, keys, MAXROWS)
+		||	!Cwsw_Sme_SoaBuild(&soa, tbl, rows, columns, SME_SOA_COLUMNS * MAXROWS)
+		||	!Cwsw_Sme_PackTable(&packed, tbl, rows, lookupstates, LOOKUP_STATES + 1, lookuptransitions, 1, lookupguards, 2, packedrows, packedfirst, MAXROWS))
+	{
+		fprintf(stderr, "bench_sme: cannot build the %u-row tables\n", rows);
+		return;
+	}
+
+	for(pos = 0; pos < 3; ++pos)
+	{
+		// the linear search runs from the last row to the first: "first" is its slowest hit.
+		tEvQ_Event ev = { (tEvQ_EventID)((pos == 0) ? 1 : (pos == 1) ? rows : (rows + 1)), 0 };
+		uint8_t state = LookupState((pos == 1) ? (rows - 1) : 0, shape);
+		pfStateHandler current = lookupstates[state];
+		uint64_t linearops = Ops(LOOKUP_WORK / rows);
+		uint64_t fastops = Ops(LOOKUP_WORK / 64);
+
+		(void)snprintf(name, sizeof(name), "find_linear%s", suffix);
+		MEASURE(name, rows, positions[pos], linearops,
+			sink += (uintptr_t)Cwsw_Sme_FindNextState(tbl, rows, current, ev, 0));
+
+		(void)snprintf(name, sizeof(name), "find_indexed%s", suffix);
+		MEASURE(name, rows, positions[pos], (shape == kShape_Guarded) ? linearops : fastops,
+			sink += (uintptr_t)Cwsw_Sme_FindNextStateIndexed(&index, current, ev, 0));
+
+		(void)snprintf(name, sizeof(name), "find_soa%s", suffix);
+		MEASURE(name, rows, positions[pos], linearops,
+			sink += (uintptr_t)Cwsw_Sme_FindNextStateSoa(&soa, current, ev, 0));
+
+		(void)snprintf(name, sizeof(name), "find_packed%s", suffix);
+		MEASURE(name, rows, positions[pos], linearops,
+			sink += Cwsw_Sme_FindNextStatePacked(&packed, state, ev, 0));
+	}
+}
+
+/* for the step measurements: Stay never leaves; Hop and Skip leave on every step. */
+static tStateReturnCodes Stay(ptEvQ_Event pev, uint32_t *pextra)	{ (void)pev; (void)pextra; return kStateOperational; }
+static tStateReturnCodes Hop(ptEvQ_Event pev, uint32_t *pextra)		{ (void)pev; (void)pextra; return kStateFinished; }
+static tStateReturnCodes Skip(ptEvQ_Event pev, uint32_t *pextra)	{ (void)pev; (void)pextra; return kStateFinished; }
+
+/** Full SME steps, with and without a transition, stepwise and run to completion. */
+static void
+BenchSteps(void)
+{
+	static tTransitionTable steptbl[] = {
+		{ Stay, evGo, 0, 0, Hop,  NULL, NULL, kSmeMatch_Default },
+		{ Hop,  0,    0, 0, Skip, NULL, NULL, kSmeMatch_StateOnly },
+		{ Skip, 0,    0, 0, Hop,  NULL, NULL, kSmeMatch_StateOnly },
+	};
+	tEvQ_Event tick = { evTick, 0 };
+	pfStateHandler state;
+
+	state = Stay;
+	MEASURE("sme_step_stay", 3, "-", Ops(STEP_OPS),
+		state = Cwsw_Sme__SME(steptbl, 3, state, tick, 0));
+	sink += (uintptr_t)state;
+
+	state = Hop;
+	MEASURE("sme_step_transition", 3, "-", Ops(STEP_OPS),
+		state = Cwsw_Sme__SME(steptbl, 3, state, tick, 0));
+	sink += (uintptr_t)state;
+
+	// each call chains through one transition, then stops at the bound.
+	state = Hop;
+	MEASURE("sme_rtc_transition", 3, "-", Ops(STEP_OPS),
+		state = Cwsw_Sme__SMERunToCompletion(steptbl, 3, state, tick, 0, 1, NULL));
+	sink += (uintptr_t)state;
+}
+
+/** Body of each stoplight state, as the template writes it. */
+static tStateReturnCodes
+Light(tStateReturnCodes *pphase, int32_t *ptimer, int32_t ticks, uint32_t self, ptEvQ_Event pev, uint32_t *pextra)
+{
+	switch(*pphase)
+	{
+	case kStateUninit:
+	default:
+		*ptimer = ticks;
+		*pphase = kStateOperational;
+		break;
+
+	case kStateOperational:
+		if(pev->evId == evGo)										{ *pphase = kStateExit; }
+		else if((pev->evId == evTick) && (--*ptimer <= 0))			{ *pphase = kStateExit; }
+		break;
+
+	case kStateExit:
+		pev->evId = evTimeout;
+		pev->evData = 0;
+		*pextra = self;
+		*pphase = kStateFinished;
+		break;
+	}
+	return *pphase;
+}
+
+static tStateReturnCodes Red(ptEvQ_Event pev, uint32_t *pextra)		{ return Light(&redphase, &redtimer, STOPLIGHT_RED, kRed, pev, pextra); }
+static tStateReturnCodes Green(ptEvQ_Event pev, uint32_t *pextra)	{ return Light(&greenphase, &greentimer, STOPLIGHT_GREEN, kGreen, pev, pextra); }
+static tStateReturnCodes Yellow(ptEvQ_Event pev, uint32_t *pextra)	{ return Light(&yellowphase, &yellowtimer, STOPLIGHT_YELLOW, kYellow, pev, pextra); }
+
+static tTransitionTable		lighttbl[] = {
+	{ Red,    evTimeout, 0, kRed,    Green,  NULL, NULL, kSmeMatch_Default },
+	{ Green,  evTimeout, 0, kGreen,  Yellow, NULL, NULL, kSmeMatch_Default },
+	{ Yellow, evTimeout, 0, kYellow, Red,    NULL, NULL, kSmeMatch_Default },
+};
+
+/** One stoplight event: the next tick, unless a button press comes first. */
+static pfStateHandler
+StoplightEvent(pfStateHandler state, uint32_t *pnow, uint32_t *pnextgo, uint32_t maxchain)
+{
+	tEvQ_Event ev;
+
+	if(*pnextgo <= *pnow + STOPLIGHT_TICK)
+	{
+		*pnow = *pnextgo;
+		*pnextgo += STOPLIGHT_GO;
+		ev.evId = evGo;
+	}
+	else
+	{
+		*pnow += STOPLIGHT_TICK;
+		ev.evId = evTick;
+	}
+	ev.evData = *pnow;
+	if(maxchain)	{ return Cwsw_Sme__SMERunToCompletion(lighttbl, 3, state, ev, 0, maxchain, NULL); }
+	return Cwsw_Sme__SME(lighttbl, 3, state, ev, 0);
+}
+
+/** The stoplight, driven on a simulated clock by its periodic tick plus "go" button presses. */
+static void
+BenchStoplight(char const *name, uint32_t maxchain)
+{
+	uint32_t now = 0;
+	uint32_t nextgo = STOPLIGHT_GO;
+	pfStateHandler state = Red;
+
+	redphase = greenphase = yellowphase = kStateUninit;
+	MEASURE(name, 3, "-", Ops(STEP_OPS),
+		state = StoplightEvent(state, &now, &nextgo, maxchain));
+	sink += (uintptr_t)state;
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(int argc, char *argv[])
+{
+	static uint32_t const sizes[] = { 8, 64, 512, MAXROWS };
+	uint32_t idx;
+
+	if((argc > 1) && (strcmp(argv[1], "--quick") == 0))
+	{
+		opsdivisor = 100;
+	}
+	else if(argc > 1)
+	{
+		fprintf(stderr, "usage: %s [--quick]\n", argv[0]);
+		return 2;
+	}
+
+	printf("name,rows,position,ns_per_op,events_per_s\n");
+	for(idx = 0; idx < sizeof(sizes) / sizeof(sizes[0]); ++idx)
+	{
+		BenchLookups(sizes[idx], kShape_Keyed);
+	}
+	for(idx = 0; idx < sizeof(sizes) / sizeof(sizes[0]); ++idx)
+	{
+		BenchLookups(sizes[idx], kShape_Guarded);
+	}
+	for(idx = 0; idx < sizeof(sizes) / sizeof(sizes[0]); ++idx)
+	{
+		BenchLookups(sizes[idx], kShape_States);
+	}
+	BenchSteps();
+	BenchStoplight("stoplight_step", 0);
+	BenchStoplight("stoplight_rtc", CWSW_SME_RTC_MAXCHAIN);
+	return 0;
+}
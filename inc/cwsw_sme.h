@@ -16,6 +16,9 @@
 // ============================================================================
 
 // ----	System Headers --------------------------
+#include <stdbool.h>
+#include <stddef.h>		/* size_t */
+#include <stdint.h>
 
 // ----	Project Headers -------------------------
 #include "cwsw_swtimer.h"		/* tCwswSwAlarm */
@@ -33,6 +36,46 @@ extern "C" {
 // ----	Constants and Type Definitions ----------------------------------------
 // ============================================================================
 
+/** Enable the transition trace ring.
+ *	When 0, tracing is removed entirely, along with its API; the transition path carries no cost.
+ *	The ring has a single writer: with tracing on, every machine is stepped on one thread. The
+ *	multi-threaded scheduler does not build with it.
+ */
+#if !defined(CWSW_SME_TRACE)
+#define CWSW_SME_TRACE			(0)
+#endif
+
+/** Default bound on the transitions taken in one run-to-completion step. */
+#if !defined(CWSW_SME_RTC_MAXCHAIN)
+#define CWSW_SME_RTC_MAXCHAIN	(8)
+#endif
+
+/** Number of event IDs covered by the event-interest sets.
+ *	Events with IDs at or above this value are always dispatched.
+ */
+#if !defined(CWSW_SME_INTEREST_EVENTS)
+#define CWSW_SME_INTEREST_EVENTS	(64)
+#endif
+
+/** Enable the runtime statistics: per-state entries and dwell time, per-row hits, lookup misses,
+ *	and step latency. When 0, they are removed entirely, along with their API.
+ */
+#if !defined(CWSW_SME_STATS)
+#define CWSW_SME_STATS			(0)
+#endif
+
+/** Use the SSE2 or AVX2 kernel, when the compiler targets either, for structure-of-arrays tables.
+ *	When 0, or when neither is available, the portable scalar kernel is used.
+ */
+#if !defined(CWSW_SME_SIMD)
+#define CWSW_SME_SIMD			(1)
+#endif
+
+/** Depth, in records, of the transition trace ring. Must be a power of 2. */
+#if !defined(CWSW_SME_TRACE_DEPTH)
+#define CWSW_SME_TRACE_DEPTH	(64)
+#endif
+
 /** Return codes for the various State handlers.
  *	Each State Machine state has an internal lifetime, beginning with initialization (entry action),
  *	spending most of its time in the normal phase, and dying with an exit action. The values listed
@@ -85,9 +128,39 @@ typedef enum eStateReturnCodes {
 typedef tStateReturnCodes (*pfStateHandler)(ptEvQ_Event ev, uint32_t *extra);
 
 
+/** Guard function for one row of the transition table.
+ *	Called only once the reasons compared by the row have all matched, with the same arguments the
+ *	row's transition function would receive. The row is eligible only if the guard returns true;
+ *	otherwise, the search continues with the preceding rows.
+ */
+typedef bool (*pfSmeGuard)(tEvQ_Event ev, uint32_t extra);
+
+/** Exit reasons compared for one row of the transition table.
+ *	The value 0 selects the original behavior, and is what a row gets when it doesn't list a match
+ *	mask: reason1 and reason3 are compared; reason2 is not, because in the button-reading component
+ *	it carries the button being acted upon.
+ */
+enum eSmeMatch {
+	kSmeMatch_Default	= 0x00,		//!< compare reason1 and reason3
+	kSmeMatch_Reason1	= 0x01,		//!< compare reason1 to the event's evId
+	kSmeMatch_Reason2	= 0x02,		//!< compare reason2 to the event's evData
+	kSmeMatch_Reason3	= 0x04,		//!< compare reason3 to the `extra` argument
+	kSmeMatch_StateOnly	= 0x08		//!< compare no reasons; every exit from the state is eligible
+};
+
 /** State transition table.
  *	In order for the SME to know how the states are connected together, it needs some metadata.
  *	This table provides that.
+ *
+ *	When the current state exits, its rows are considered from last to first. A row is eligible
+ *	when the exit reasons named by its match mask all match, and its guard, if any, returns true;
+ *	the first eligible row (i.e., the last one in the table) is selected.
+ *
+ *	The guard and the match mask were added at the end of the row, which grew from 40 to 56 bytes
+ *	on a 64-bit (LP64) host, and from 24 to 32 bytes on a 32-bit (ILP32) one. Existing tables still
+ *	compile unchanged, since the fields they leave out are zero-initialized (no guard, default
+ *	match); but code built against the old layout is not binary-compatible, and must be rebuilt.
+ *	Where the table must fit in little ROM, see the packed encoding, tSmePackedRow.
  */
 typedef struct sTransitionTable {
 	pfStateHandler	pfCurrent;	// current state
@@ -100,9 +173,325 @@ typedef struct sTransitionTable {
 	 * contextual information, not the parameters normal to event usage.
 	 */
 	ptEvQ_EvHandlerFunc	pfTransition;
+	pfSmeGuard		pfGuard;	// optional guard, called only if the reasons match
+	uint8_t			match;		// reasons compared: kSmeMatch_xxx flags, or kSmeMatch_Default
 } tTransitionTable, *ptTransitionTable;
 
 
+/** One key of a compiled transition table.
+ *	This is a transition-table row reduced to the fields that take part in the search. The keys are
+ *	ordered by state, then by exit reasons, then by *descending* row number, so that the first
+ *	eligible key found for a given (state, reason1, reason3) names the same row the linear search
+ *	would select. Rows whose match mask leaves out reason1 or reason3 can't be keyed on those; they
+ *	are kept, unkeyed, after the keyed rows of their state.
+ */
+typedef struct sSmeIndexKey {
+	uintptr_t	state;		// current state, used only as an ordinal
+	uint32_t	unkeyed;	// 1 if the row doesn't compare both reason1 and reason3
+	uint32_t	reason1;	// copy of the row's reason1; 0 for an unkeyed row
+	uint32_t	reason3;	// copy of the row's reason3; 0 for an unkeyed row
+	uint32_t	row;		// row number in the source transition table
+} tSmeIndexKey, *ptSmeIndexKey;
+
+/** Compiled transition table.
+ *	Built once by Cwsw_Sme_CompileTable(), over storage provided by the caller. After compilation,
+ *	the source table must not be modified; the index holds copies of the search fields.
+ */
+typedef struct sSmeTransitionIndex {
+	ptTransitionTable	pTbl;		// source transition table
+	uint32_t			szTbl;		// size in rows of the source transition table
+	ptSmeIndexKey		pKeys;		// caller-provided key storage, one key per row
+	uint32_t			nKeys;		// number of valid keys
+	uint32_t			nUnkeyed;	// number of unkeyed rows
+} tSmeTransitionIndex, *ptSmeTransitionIndex;
+
+
+/** Number of uint32_t columns in a structure-of-arrays transition table. */
+#define SME_SOA_COLUMNS		(7)
+
+/** Structure-of-arrays transition table.
+ *	The search fields of a transition table, one column per field, so that several rows can be
+ *	compared at once. Each compared field is held as a value and a mask: a row's fields match when,
+ *	for every field, `(key ^ value) & mask` is 0; a reason the row doesn't compare has a mask of 0.
+ *	Only the low 32 bits of the current state are held, so a row whose fields match is confirmed
+ *	against its source row before its guard is called.
+ *
+ *	Built by Cwsw_Sme_SoaBuild(), over one array of `SME_SOA_COLUMNS * szTbl` elements provided by
+ *	the caller. The source table holds everything else (next state, transition, guard), and must
+ *	not be modified afterward.
+ */
+typedef struct sSmeSoaTable {
+	ptTransitionTable	pTbl;		// source transition table
+	uint32_t			szTbl;		// size in rows of the source transition table
+	uint32_t			*pState;	// low 32 bits of the current state
+	uint32_t			*pReason1;	// reason1
+	uint32_t			*pReason2;	// reason2
+	uint32_t			*pReason3;	// reason3
+	uint32_t			*pMask1;	// all 1s if reason1 is compared, else 0
+	uint32_t			*pMask2;	// all 1s if reason2 is compared, else 0
+	uint32_t			*pMask3;	// all 1s if reason3 is compared, else 0
+} tSmeSoaTable, *ptSmeSoaTable;
+
+
+/** One row of a packed transition table.
+ *	The same row as tTransitionTable, with every pointer replaced by a small index: states index
+ *	the table's state list, and transition and guard functions index its function lists. Index 0
+ *	means "none" in each list (for states, it mirrors kStateNone), so element 0 of each list is
+ *	NULL. The compared reasons are narrowed to 16 bits; a reason the row doesn't compare is 0.
+ *	The match mask is held resolved, so the search needn't interpret it: a row written with
+ *	kSmeMatch_Default has `kSmeMatch_Reason1 | kSmeMatch_Reason3`, and one with kSmeMatch_StateOnly
+ *	has 0.
+ *
+ *	A row takes 12 bytes, against 56 for a tTransitionTable on a 64-bit host.
+ */
+typedef struct sSmePackedRow {
+	uint16_t	reason1;	// as tTransitionTable.reason1
+	uint16_t	reason2;	// as tTransitionTable.reason2
+	uint16_t	reason3;	// as tTransitionTable.reason3
+	uint8_t		current;	// index of the current state
+	uint8_t		next;		// index of the next state
+	uint8_t		transition;	// index of the transition function; 0 for none
+	uint8_t		guard;		// index of the guard function; 0 for none
+	uint8_t		match;		// reasons compared: kSmeMatch_Reason1/2/3 flags, resolved; 0 for none
+	uint8_t		rsvd;		// reserved; 0
+} tSmePackedRow;
+
+/** Packed, read-only transition table.
+ *	Holds no pointers to mutable data, so the table, its rows and its lists can all be declared
+ *	`const`, placed in rodata, and shared. Rows may be written by hand, with the state enumeration
+ *	as state indices, or built from a tTransitionTable by Cwsw_Sme_PackTable().
+ *
+ *	`pFirst` is optional. When present, the rows are grouped by current state, and the rows of
+ *	state `n` are `pRows[pFirst[n]]` up to, but not including, `pRows[pFirst[n + 1]]`; the search
+ *	then visits only the current state's rows. Otherwise, every row is visited.
+ */
+typedef struct sSmePackedTable {
+	tSmePackedRow const			*pRows;			// rows, in table order within each state
+	uint32_t					nRows;			// number of rows
+	uint16_t const				*pFirst;		// optional; first row of each state, nStates + 1 elements
+	pfStateHandler const		*pStates;		// state list; element 0 is NULL
+	uint32_t					nStates;		// elements in the state list; at most 256
+	ptEvQ_EvHandlerFunc const	*pTransitions;	// transition functions; element 0 is NULL
+	pfSmeGuard const			*pGuards;		// guard functions; element 0 is NULL. may be NULL if no row has a guard
+} tSmePackedTable, *ptSmePackedTable;
+
+
+/** One state's place in a hierarchical state machine.
+ *	Declared alongside the transition table, one entry per state that has a parent, or that is
+ *	itself a parent (a composite state). States not listed are top-level simple states.
+ *
+ *	A composite state is named by a pfStateHandler, like any other state, so that it can appear in
+ *	the transition table; but the SME never calls it. Only simple (leaf) states are ever current.
+ *	A row for a composite state applies to every state nested within it, unless a row for the
+ *	nested state itself is eligible. A row whose next state is composite enters that composite's
+ *	initial state.
+ */
+typedef struct sSmeHsmState {
+	pfStateHandler		state;		// the state
+	pfStateHandler		parent;		// enclosing composite state; NULL at the top level
+	pfStateHandler		initial;	// composite states only: the nested state entered by default
+	ptEvQ_EvHandlerFunc	pfEntry;	// composite states only: entry action; optional
+	ptEvQ_EvHandlerFunc	pfExit;		// composite states only: exit action; optional
+} tSmeHsmState, *ptSmeHsmState;
+
+/** Actions of one flattened transition, as a slice of the hierarchy's action list.
+ *	The exit actions come first, innermost first; then the entry actions, outermost first.
+ */
+typedef struct sSmeHsmPath {
+	uint32_t	first;		// first action of this transition in the action list
+	uint16_t	nExit;		// number of exit actions
+	uint16_t	nEntry;		// number of entry actions
+} tSmeHsmPath, *ptSmeHsmPath;
+
+/** Hierarchical state machine, flattened ahead of time.
+ *	Built once by Cwsw_Sme_Hsm_Init(), over caller-provided storage. The flattened table has rows
+ *	for simple states only: each simple state gets its own rows, preceded by those it inherits from
+ *	its enclosing states, so that the innermost eligible row wins. Each flattened row has its
+ *	composite exit and entry actions, through the least common ancestor of the transition,
+ *	precomputed. A transition at any depth is then one lookup, plus a walk of its action list.
+ */
+typedef struct sSmeHsm {
+	tSmeHsmState const		*pStates;	// hierarchy declaration
+	uint32_t				nStates;	// entries in the hierarchy declaration
+	ptTransitionTable		pFlat;		// flattened transition table
+	uint32_t				szFlat;		// size in rows of the flattened table
+	ptSmeHsmPath			pPaths;		// one path per flattened row
+	ptEvQ_EvHandlerFunc		*pActions;	// exit and entry actions of every flattened row
+	uint32_t				nActions;	// number of actions in the action list
+	ptSmeTransitionIndex	pIndex;		// optional compiled form of pFlat; used instead of pFlat if set
+} tSmeHsm, *ptSmeHsm;
+
+/** Number of 32-bit words in one event-interest set. */
+#define SME_INTEREST_WORDS	((CWSW_SME_INTEREST_EVENTS + 31) / 32)
+
+/** An internal reaction, declared to the SME.
+ *	States react to some events without leaving the state (a periodic tick that polls a timer, for
+ *	example). Those events appear nowhere in the transition table, so they must be declared for the
+ *	state to keep receiving them when event filtering is in use.
+ */
+typedef struct sSmeReaction {
+	pfStateHandler	state;		// state that reacts
+	tEvQ_EventID	evId;		// event it reacts to
+} tSmeReaction, *ptSmeReaction;
+
+/** The events one state has a reaction to, as a bitset indexed by event ID. */
+typedef struct sSmeInterestEntry {
+	uintptr_t	state;							// state, used only as an ordinal
+	uint32_t	events[SME_INTEREST_WORDS];		// bit n set: the state reacts to event ID n
+} tSmeInterestEntry, *ptSmeInterestEntry;
+
+/** Event-interest sets for the states of one machine.
+ *	Built by Cwsw_Sme_Interest_Build(), over caller-provided storage, from the transition table and
+ *	the declared internal reactions; for a hierarchical machine, from its flattened table. States
+ *	that don't appear in the sets receive every event. The counters are updated atomically, as the
+ *	instances of a pool may be stepped on several threads at once.
+ */
+typedef struct sSmeInterest {
+	ptSmeInterestEntry	pEntries;		// one entry per state, sorted by state
+	uint32_t			nEntries;		// number of valid entries
+	uint32_t			dispatched;		// events passed to a state
+	uint32_t			skipped;		// events filtered out before reaching a state
+} tSmeInterest, *ptSmeInterest;
+
+/** Handle of one SME instance: its position in an instance pool. */
+typedef uint32_t tSmeInstance;
+
+/** Handle value returned when an instance cannot be allocated. */
+#define kSmeInstanceNone	((tSmeInstance)0xFFFFFFFFu)
+
+struct sSmePool;
+struct sSmeWheel;
+
+/** Context passed to instance-aware state handlers.
+ *	Identifies the instance being driven; the instance's data is reached through the SME_INST_xxx
+ *	accessors below.
+ */
+typedef struct sSmeInstCtx {
+	struct sSmePool	*pPool;		// pool that owns the instance
+	tSmeInstance	inst;		// instance within the pool
+} tSmeInstCtx, *ptSmeInstCtx;
+
+/** Prototype for instance-aware State Machine handlers.
+ *	Identical in role to pfStateHandler, except that the state's phase, timer and exit reasons live
+ *	in the instance pool rather than in function-local `static` variables, so one set of handlers
+ *	can drive any number of machines.
+ */
+typedef tStateReturnCodes (*pfSmeInstStateHandler)(ptSmeInstCtx pCtx, ptEvQ_Event ev, uint32_t *extra);
+
+/** Place an instance-aware state handler in a transition table.
+ *	The table holds every state as a pfStateHandler; the SME only compares it, and casts it back to
+ *	pfSmeInstStateHandler before calling it. The cast through a generic function pointer type keeps
+ *	compilers from warning about the (intentional) signature mismatch.
+ */
+#define SME_INST_STATE(fn)		((pfStateHandler)(void (*)(void))(fn))
+
+/** Pool of identical SME instances.
+ *	All instances share one transition table and one set of handlers. The per-instance data is kept
+ *	as a structure of arrays, one element per instance, so stepping many instances walks memory
+ *	sequentially. The arrays are provided by the caller and must each hold `capacity` elements
+ *	(`capacity * szUser` bytes for pUser).
+ */
+typedef struct sSmePool {
+	ptTransitionTable		pTbl;		// transition table shared by every instance
+	uint32_t				szTbl;		// size in rows of the transition table
+	ptSmeTransitionIndex	pIndex;		// optional compiled form of pTbl; used instead of pTbl if set
+	uint32_t				capacity;	// number of elements in each per-instance array
+	uint32_t				count;		// number of instances allocated
+	pfStateHandler			*pState;	// current state
+	tStateReturnCodes		*pPhase;	// state phase (the template's `statephase`)
+	tCwswClockTics			*pTimer;	// state timer
+	tEvQ_EventID			*pEvId;		// saved exit reason 1
+	uint8_t					*pUser;		// optional application data, szUser bytes per instance
+	uint32_t				szUser;		// size in bytes of each instance's application data
+	uint32_t				maxchain;	// 0: stepwise; else run to completion, with at most this many transitions per step
+	ptSmeInterest			pInterest;	// optional; if set, operational states only receive events they react to. built from pHsm->pFlat if pHsm is set
+	ptSmeHsm				pHsm;		// optional; if set, the machine is hierarchical, and pTbl/pIndex are not used
+	struct sSmeWheel		*pWheel;	// optional; timing wheel for the instances' state timeouts
+	tCwswClockTics			*pEntered;	// optional; with CWSW_SME_STATS, time each instance entered its current state
+} tSmePool, *ptSmePool;
+
+/** Per-instance data accessors, for use within an instance-aware state handler. */
+#define SME_INST_PHASE(pctx)	((pctx)->pPool->pPhase[(pctx)->inst])
+#define SME_INST_TIMER(pctx)	((pctx)->pPool->pTimer[(pctx)->inst])
+#define SME_INST_EVID(pctx)		((pctx)->pPool->pEvId[(pctx)->inst])
+#define SME_INST_USER(pctx)		((void *)&(pctx)->pPool->pUser[(size_t)(pctx)->inst * (pctx)->pPool->szUser])
+
+/** One entry of an instance batch: an event addressed to one instance of a pool. */
+typedef struct sSmeInstEvent {
+	tSmeInstance	inst;		// instance to drive
+	tEvQ_Event		ev;			// event for that instance
+	uint32_t		extra;		// extra parameter for that instance
+} tSmeInstEvent, *ptSmeInstEvent;
+
+/** Time source for the SME's instrumentation.
+ *	The SME has no clock of its own; the project supplies one with Cwsw_Sme_SetTimeSource().
+ */
+typedef tCwswClockTics (*pfSmeTimeSource)(void);
+
+#if (CWSW_SME_STATS)
+/** Number of buckets in each statistics histogram.
+ *	Bucket 0 counts durations of 0 tics; bucket `b` counts durations from 2^(b-1) up to, but not
+ *	including, 2^b tics; the last bucket also counts everything longer.
+ */
+#define SME_STATS_BUCKETS		(16)
+
+/** Size of a cache line, for the alignment of the statistics blocks. */
+#if !defined(SME_CACHE_LINE)
+#define SME_CACHE_LINE			(64)
+#endif
+
+#if defined(__cplusplus)
+#define SME_CACHE_ALIGNED		alignas(SME_CACHE_LINE)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define SME_CACHE_ALIGNED		_Alignas(SME_CACHE_LINE)
+#elif defined(__GNUC__)
+#define SME_CACHE_ALIGNED		__attribute__((aligned(SME_CACHE_LINE)))
+#else
+#define SME_CACHE_ALIGNED
+#endif
+
+/** Statistics block.
+ *	One block per thread that runs the SME, selected by that thread with Cwsw_Sme_Stats_Select(),
+ *	so that each block has one writer and no counter is shared between threads; the blocks are
+ *	aligned to cache lines to keep it so. The arrays are provided by the caller; any of them may be
+ *	NULL, which turns off the statistics kept there.
+ *
+ *	States are identified by their position in `pStates`, as in a packed table. Row numbers are
+ *	those of the table the engine searched: the source table for the linear, indexed and
+ *	structure-of-arrays searches, the flattened table for a hierarchy, the packed rows for a
+ *	packed table. Dwell time needs each machine's entry time, which is kept with the machine, not
+ *	here: in the pool's `pEntered` for pool instances, or, for a plain machine, in storage its
+ *	caller names with Cwsw_Sme_Stats_Machine().
+ */
+typedef struct sSmeStats {
+	SME_CACHE_ALIGNED uint32_t	steps;		// SME steps run
+	uint32_t				misses;			// lookups that selected no row
+	uint32_t				latency[SME_STATS_BUCKETS];	// histogram of step durations
+	pfStateHandler const	*pStates;		// states tracked
+	uint32_t				nStates;		// elements in pStates
+	uint32_t				*pEntries;		// entries into each state; nStates elements
+	uint32_t				*pDwell;		// histogram of time spent in each state; nStates * SME_STATS_BUCKETS elements
+	uint32_t				*pRowHits;		// times each row was selected; szRows elements
+	uint32_t				szRows;			// elements in pRowHits
+} tSmeStats, *ptSmeStats;
+#endif
+
+#if (CWSW_SME_TRACE)
+/** One record of the transition trace ring.
+ *	Written by the SME each time a transition-table row is selected.
+ */
+typedef struct sSmeTraceRecord {
+	tCwswClockTics	timestamp;	// time of the transition, per the SME time source
+	uint32_t		row;		// selected row in the transition table
+	pfStateHandler	pfFrom;		// state being exited
+	pfStateHandler	pfTo;		// state being entered
+	tEvQ_EventID	evId;		// exit reason 1
+	uint32_t		evData;		// exit reason 2
+	uint32_t		extra;		// exit reason 3
+} tSmeTraceRecord, *ptSmeTraceRecord;
+#endif
+
+
 // ============================================================================
 // ----	Public Variables ------------------------------------------------------
 // ============================================================================
@@ -124,6 +513,165 @@ Cwsw_Sme__SME(
 	pfStateHandler CurrentState,
 	tEvQ_Event ev, uint32_t extra);
 
+extern pfStateHandler
+Cwsw_Sme__SMERunToCompletion(
+	ptTransitionTable pTblTransitions, uint32_t sztbl,	// individual component's transition table
+	pfStateHandler CurrentState,
+	tEvQ_Event ev, uint32_t extra,
+	uint32_t maxtransitions,							// bound on transitions per call; 0 for the default
+	uint32_t *ptransitions);							// optional; transitions taken
+
+extern bool Cwsw_Sme_CompileTable(
+	ptSmeTransitionIndex	pIndex,				// index to build
+	ptTransitionTable		pTblTransition,		// pointer to 1st row of transition table
+	uint32_t				szTblTransition,	// size in rows of the transition table
+	ptSmeIndexKey			pKeys,				// caller-provided key storage
+	uint32_t				szKeys);			// size in keys of the key storage; must be >= szTblTransition
+
+extern pfStateHandler Cwsw_Sme_FindNextStateIndexed(
+	ptSmeTransitionIndex	pIndex,
+	pfStateHandler			currentstate,
+	tEvQ_Event				ev,
+	uint32_t				extra);
+
+extern pfStateHandler
+Cwsw_Sme__SMEIndexed(
+	ptSmeTransitionIndex pIndex,						// individual component's compiled transition table
+	pfStateHandler CurrentState,
+	tEvQ_Event ev, uint32_t extra);
+
+extern bool Cwsw_Sme_SoaBuild(
+	ptSmeSoaTable			pSoa,				// table to build
+	ptTransitionTable		pTblTransition,		// pointer to 1st row of transition table
+	uint32_t				szTblTransition,	// size in rows of the transition table
+	uint32_t				*pColumns,			// caller-provided column storage
+	uint32_t				szColumns);			// elements in pColumns; must be >= SME_SOA_COLUMNS * szTblTransition
+
+extern pfStateHandler Cwsw_Sme_FindNextStateSoa(
+	ptSmeSoaTable			pSoa,
+	pfStateHandler			currentstate,
+	tEvQ_Event				ev,
+	uint32_t				extra);
+
+extern pfStateHandler
+Cwsw_Sme__SMESoa(
+	ptSmeSoaTable pSoa,									// individual component's structure-of-arrays table
+	pfStateHandler CurrentState,
+	tEvQ_Event ev, uint32_t extra);
+
+extern bool Cwsw_Sme_PackTable(
+	ptSmePackedTable			pPacked,			// packed table to build
+	ptTransitionTable			pTblTransition,		// pointer to 1st row of transition table
+	uint32_t					szTblTransition,	// size in rows of the transition table
+	pfStateHandler const		*pStates,			// state list; element 0 is NULL
+	uint32_t					nStates,			// elements in the state list; at most 256
+	ptEvQ_EvHandlerFunc const	*pTransitions,		// transition functions; element 0 is NULL
+	uint32_t					nTransitions,		// elements in the transition list; at most 256
+	pfSmeGuard const			*pGuards,			// guard functions; element 0 is NULL. optional
+	uint32_t					nGuards,			// elements in the guard list; at most 256
+	tSmePackedRow				*pRows,				// caller-provided storage, one row per transition-table row
+	uint16_t					*pFirst,			// caller-provided storage, nStates + 1 elements
+	uint32_t					szRows);			// size in rows of pRows; must be >= szTblTransition
+
+extern uint8_t Cwsw_Sme_FindNextStatePacked(
+	tSmePackedTable const	*pPacked,
+	uint8_t					currentstate,		// index of the current state
+	tEvQ_Event				ev,
+	uint32_t				extra);
+
+extern uint8_t
+Cwsw_Sme__SMEPacked(
+	tSmePackedTable const *pPacked,						// individual component's packed transition table
+	uint8_t CurrentState,								// index of the current state
+	tEvQ_Event ev, uint32_t extra);
+
+extern pfStateHandler
+Cwsw_Sme__SMEBatch(
+	ptTransitionTable pTblTransitions, uint32_t sztbl,	// individual component's transition table
+	pfStateHandler CurrentState,
+	tEvQ_Event const *pEvents, uint32_t const *pExtras,	// events, and optionally their extra parameters
+	uint32_t nEvents,
+	pfStateHandler *pNextStates);						// optional; the state after each event
+
+extern bool Cwsw_Sme_Hsm_Size(
+	tSmeHsmState const		*pStates,			// hierarchy declaration
+	uint32_t				nStates,			// entries in the hierarchy declaration
+	ptTransitionTable		pTblTransition,		// pointer to 1st row of transition table
+	uint32_t				szTblTransition,	// size in rows of the transition table
+	uint32_t				*pszFlat,			// receives the rows needed for the flattened table
+	uint32_t				*pnActions);		// receives the entries needed for the action list
+
+extern bool Cwsw_Sme_Hsm_Init(
+	ptSmeHsm				pHsm,				// hierarchy to build
+	tSmeHsmState const		*pStates,			// hierarchy declaration
+	uint32_t				nStates,			// entries in the hierarchy declaration
+	ptTransitionTable		pTblTransition,		// pointer to 1st row of transition table
+	uint32_t				szTblTransition,	// size in rows of the transition table
+	ptTransitionTable		pFlat,				// caller-provided storage for the flattened table
+	ptSmeHsmPath			pPaths,				// caller-provided storage, one path per flattened row
+	uint32_t				szFlat,				// size in rows of pFlat and pPaths
+	ptEvQ_EvHandlerFunc		*pActions,			// caller-provided storage for the action list
+	uint32_t				szActions);			// size in entries of pActions
+
+extern pfStateHandler Cwsw_Sme_Hsm_Resolve(ptSmeHsm pHsm, pfStateHandler state);
+
+extern pfStateHandler Cwsw_Sme_FindNextStateHsm(
+	ptSmeHsm				pHsm,
+	pfStateHandler			currentstate,
+	tEvQ_Event				ev,
+	uint32_t				extra);
+
+extern pfStateHandler
+Cwsw_Sme__SMEHsm(
+	ptSmeHsm pHsm,										// individual component's flattened hierarchy
+	pfStateHandler CurrentState,
+	tEvQ_Event ev, uint32_t extra);
+
+extern bool Cwsw_Sme_Interest_Build(
+	ptSmeInterest			pInterest,			// interest sets to build
+	ptTransitionTable		pTblTransition,		// pointer to 1st row of transition table
+	uint32_t				szTblTransition,	// size in rows of the transition table
+	tSmeReaction const		*pReactions,		// optional; declared internal reactions
+	uint32_t				nReactions,			// number of declared internal reactions
+	ptSmeInterestEntry		pEntries,			// caller-provided storage, one entry per distinct state
+	uint32_t				szEntries);			// size in entries of the storage
+
+extern bool Cwsw_Sme_Interest_Check(ptSmeInterest pInterest, pfStateHandler state, tEvQ_EventID evId);
+
+extern bool Cwsw_Sme_Pool_Init(ptSmePool pPool);
+extern tSmeInstance Cwsw_Sme_Pool_Add(ptSmePool pPool, pfStateHandler initialstate);
+
+extern pfStateHandler
+Cwsw_Sme__SMEInst(
+	ptSmePool pPool, tSmeInstance inst,					// instance to drive
+	tEvQ_Event ev, uint32_t extra);
+
+extern void
+Cwsw_Sme__SMEPool(
+	ptSmePool pPool,									// every instance in the pool
+	tEvQ_Event ev, uint32_t extra);
+
+extern uint32_t
+Cwsw_Sme__SMEInstBatch(
+	ptSmePool pPool,
+	tSmeInstEvent const *pItems, uint32_t nItems,		// (instance, event) pairs
+	pfStateHandler *pNextStates);						// optional; the state after each pair
+
+extern void Cwsw_Sme_SetTimeSource(pfSmeTimeSource pfNow);
+
+#if (CWSW_SME_STATS)
+extern bool Cwsw_Sme_Stats_Init(ptSmeStats pStats);
+extern void Cwsw_Sme_Stats_Select(ptSmeStats pStats);
+extern void Cwsw_Sme_Stats_Machine(tCwswClockTics *pEntered);
+extern bool Cwsw_Sme_Stats_Snapshot(ptSmeStats pDst, tSmeStats const *pSrc);
+#endif
+
+#if (CWSW_SME_TRACE)
+extern uint32_t Cwsw_Sme_Trace_Drain(ptSmeTraceRecord pDst, uint32_t maxrecs);
+extern uint32_t Cwsw_Sme_Trace_Lost(void);
+extern int Cwsw_Sme_Trace_Decode(tSmeTraceRecord const *pRec, char *buf, size_t szbuf);
+#endif
+
 #ifdef	__cplusplus
 }
 #endif
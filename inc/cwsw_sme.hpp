@@ -0,0 +1,257 @@
+/** @file
+ *	@brief	Compile-time specialized C++ front end for the CWSW State Machine Engine (SME).
+ *
+ *	The C engine reaches every state through a pfStateHandler, and every transition through a
+ *	ptEvQ_EvHandlerFunc; neither call can be inlined. Here, the states and the transition table are
+ *	template parameters instead. Each state is dispatched through a dense switch on the state's
+ *	index; only the rows whose current state matches that case survive compilation; the constant
+ *	exit reasons fold into the comparisons; and the handlers, whose addresses are known, can be
+ *	inlined.
+ *
+ *	The front end is ABI-compatible with the C engine: the same handlers are used, and each table
+ *	also exists as an ordinary tTransitionTable, so a machine can be moved over one at a time, or
+ *	driven by either engine.
+ *
+ *	@code
+ *	using MyStates = cwsw::sme::States<StateRed, StateGreen, StateYellow>;
+ *	using MyTable  = cwsw::sme::Table<
+ *		cwsw::sme::Row<StateRed,    evStoplite_Task, kStateRed,    StateGreen>,
+ *		cwsw::sme::Row<StateGreen,  evStoplite_Task, kStateGreen,  StateYellow>,
+ *		cwsw::sme::Row<StateYellow, evStoplite_Task, kStateYellow, StateRed, MyTransition> >;
+ *	static cwsw::sme::Machine<MyStates, MyTable> StopLite(StateRed);
+ *
+ *	// from the SME's task:
+ *	StopLite.Step(ev, extra);
+ *	@endcode
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef SME_HPP
+#define SME_HPP
+
+#if !defined(__cplusplus) || (__cplusplus < 201703L)
+#error "cwsw_sme.hpp requires C++17"
+#endif
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <cstddef>
+#include <cstdint>
+#include <utility>		/* std::index_sequence */
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme.h"
+
+
+namespace cwsw {
+namespace sme {
+
+// ============================================================================
+// ----	Constants and Type Definitions ----------------------------------------
+// ============================================================================
+
+/** The states of one machine.
+ *	The position of a state in this list is its index, which is what a Machine stores as its
+ *	current state.
+ */
+template<pfStateHandler... S>
+struct States {
+	static constexpr std::size_t count = sizeof...(S);
+	static constexpr pfStateHandler handlers[] = { S... };
+
+	/** Index of a state within the list; `count` if the state is not in the list. */
+	static constexpr std::size_t IndexOf(pfStateHandler state)
+	{
+		for(std::size_t idx = 0; idx < count; ++idx)
+		{
+			if(handlers[idx] == state)	{ return idx; }
+		}
+		return count;
+	}
+};
+
+/** One row of a compile-time transition table.
+ *	Same fields, and same matching rules, as tTransitionTable: by default, a row is eligible when
+ *	the current state, reason1 (the event ID) and reason3 (the `extra` argument) all match; the
+ *	`Match` mask selects other reasons, and the `Guard`, if any, is called only once they match.
+ */
+template<
+	pfStateHandler		From,
+	uint32_t			Reason1,
+	uint32_t			Reason3,
+	pfStateHandler		Next,
+	ptEvQ_EvHandlerFunc	Transition = nullptr,
+	uint32_t			Reason2 = 0,
+	pfSmeGuard			Guard = nullptr,
+	uint8_t				Match = kSmeMatch_Default>
+struct Row {
+	static constexpr pfStateHandler from = From;
+	static constexpr pfStateHandler next = Next;
+
+	/** This row in the C engine's representation. */
+	static constexpr tTransitionTable value = { From, Reason1, Reason2, Reason3, Next, Transition, Guard, Match };
+
+	/** Reasons compared, with kSmeMatch_Default resolved. */
+	static constexpr uint8_t match = (Match == kSmeMatch_Default)
+		? static_cast<uint8_t>(kSmeMatch_Reason1 | kSmeMatch_Reason3)
+		: static_cast<uint8_t>(Match & (kSmeMatch_Reason1 | kSmeMatch_Reason2 | kSmeMatch_Reason3));
+
+	static inline bool Matches(tEvQ_Event const &ev, uint32_t extra)
+	{
+		if constexpr ((match & kSmeMatch_Reason1) != 0)	{ if(static_cast<uint32_t>(ev.evId) != Reason1)	{ return false; } }
+		if constexpr ((match & kSmeMatch_Reason2) != 0)	{ if(ev.evData != Reason2)						{ return false; } }
+		if constexpr ((match & kSmeMatch_Reason3) != 0)	{ if(extra != Reason3)							{ return false; } }
+		if constexpr (Guard != nullptr)					{ return Guard(ev, extra); }
+		(void)ev; (void)extra;
+		return true;
+	}
+
+	static inline void Take(tEvQ_Event ev, uint32_t extra)
+	{
+		if constexpr (Transition != nullptr)	{ Transition(ev, extra); }
+		else									{ (void)ev; (void)extra; }
+	}
+};
+
+/** Compile-time transition table.
+ *	As in the C engine, when more than one row matches, the last one wins.
+ */
+template<typename... Rows>
+struct Table {
+	static constexpr uint32_t size = sizeof...(Rows);
+
+	/** The table in the C engine's representation, for use with Cwsw_Sme__SME() and friends. */
+	static inline tTransitionTable table[] = { Rows::value... };
+
+	/** Search for the next state, as Cwsw_Sme_FindNextState() does.
+	 *	The current state is a template parameter: rows for any other state are discarded at compile
+	 *	time.
+	 *
+	 *	@returns true if a row was selected; `next` then holds the next state.
+	 */
+	template<pfStateHandler Current>
+	static inline bool FindNextState(tEvQ_Event ev, uint32_t extra, pfStateHandler &next)
+	{
+		if constexpr (sizeof...(Rows) > 0)	{ return FindFrom<Current, Rows...>(ev, extra, next); }
+		else								{ (void)ev; (void)extra; (void)next; return false; }
+	}
+
+	/** As FindNextState(), but yields the next state as its index in a state list.
+	 *	The index of each row's next state is a compile-time constant.
+	 */
+	template<typename StateList, pfStateHandler Current>
+	static inline bool FindNextIndex(tEvQ_Event ev, uint32_t extra, std::size_t &nextidx)
+	{
+		if constexpr (sizeof...(Rows) > 0)	{ return FindIndexFrom<StateList, Current, Rows...>(ev, extra, nextidx); }
+		else								{ (void)ev; (void)extra; (void)nextidx; return false; }
+	}
+
+private:
+	// in both searches, later rows are tried first, so that the last matching row wins.
+	template<pfStateHandler Current, typename R, typename... Rest>
+	static inline bool FindFrom(tEvQ_Event ev, uint32_t extra, pfStateHandler &next)
+	{
+		if constexpr (sizeof...(Rest) > 0)
+		{
+			if(FindFrom<Current, Rest...>(ev, extra, next))	{ return true; }
+		}
+		if constexpr (R::from == Current)
+		{
+			if(R::Matches(ev, extra))
+			{
+				R::Take(ev, extra);
+				next = R::next;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template<typename StateList, pfStateHandler Current, typename R, typename... Rest>
+	static inline bool FindIndexFrom(tEvQ_Event ev, uint32_t extra, std::size_t &nextidx)
+	{
+		if constexpr (sizeof...(Rest) > 0)
+		{
+			if(FindIndexFrom<StateList, Current, Rest...>(ev, extra, nextidx))	{ return true; }
+		}
+		if constexpr (R::from == Current)
+		{
+			if(R::Matches(ev, extra))
+			{
+				constexpr std::size_t idx = StateList::IndexOf(R::next);
+				R::Take(ev, extra);
+				nextidx = idx;
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+/** One state machine, specialized at compile time on its states and its transition table.
+ *	Every state reachable through the table must appear in the state list.
+ */
+template<typename StateList, typename Tbl>
+class Machine {
+public:
+	explicit Machine(pfStateHandler initial) : current(StateList::IndexOf(initial)) {}
+
+	/** One SME step: equivalent to `state = Cwsw_Sme__SME(Tbl::table, Tbl::size, state, ev, extra)`.
+	 *	@returns The next state; NULL if the current state is not in the state list.
+	 */
+	pfStateHandler Step(tEvQ_Event ev, uint32_t extra)
+	{
+		StepImpl(std::make_index_sequence<StateList::count>{}, ev, extra);
+		return State();
+	}
+
+	/** Current state, as a handler. */
+	pfStateHandler State() const
+	{
+		return (current < StateList::count) ? StateList::handlers[current] : nullptr;
+	}
+
+	/** Current state, as an index into the state list. */
+	std::size_t StateIndex() const	{ return current; }
+
+	/** Force the current state; for handing a machine over from the C engine. */
+	void SetState(pfStateHandler state)	{ current = StateList::IndexOf(state); }
+
+private:
+	std::size_t current;
+
+	// expands to a dense switch on the current state's index.
+	template<std::size_t... I>
+	void StepImpl(std::index_sequence<I...>, tEvQ_Event ev, uint32_t extra)
+	{
+		(void)((current == I ? (current = StepState<I>(ev, extra), true) : false) || ...);
+	}
+
+	template<std::size_t I>
+	static std::size_t StepState(tEvQ_Event ev, uint32_t extra)
+	{
+		constexpr pfStateHandler state = StateList::handlers[I];
+		std::size_t nextidx = I;
+
+		if(state(&ev, &extra) > kStateExit)
+		{
+			(void)Tbl::template FindNextIndex<StateList, state>(ev, extra, nextidx);
+		}
+		return nextidx;
+	}
+};
+
+} // namespace sme
+} // namespace cwsw
+
+#endif /* SME_HPP */
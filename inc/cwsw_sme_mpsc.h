@@ -0,0 +1,88 @@
+/** @file
+ *	@brief	Lock-free, bounded, multi-producer / single-consumer event queues for SME instances.
+ *
+ *	Each instance of a pool gets its own queue, so threads that post to different instances never
+ *	touch the same memory, and threads that post to the same instance never take a lock. A producer
+ *	reserves a slot, fills in the event in place, and commits it; the engine runs the committed
+ *	events directly from their slots, a batch at a time.
+ *
+ *	Each queue is a ring of slots with a sequence number per slot. A producer claims the next slot
+ *	with one compare-and-swap; the slot's sequence number then tells the consumer when the producer
+ *	has committed it, and tells the producers when the consumer has released it. Events are
+ *	consumed in the order their slots were reserved; a slot reserved but not yet committed holds
+ *	back the slots after it, so commit promptly.
+ *
+ *	@note This component is intended for hosts; it requires C11 atomics, and allocates its working
+ *	storage at creation. At most one thread at a time may consume a given instance's queue. With
+ *	CWSW_SME_TRACE on, consume every queue on the same thread: the trace ring has one writer.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef SME_MPSC_H
+#define SME_MPSC_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdbool.h>
+#include <stdint.h>
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme.h"
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants and Type Definitions ----------------------------------------
+// ============================================================================
+
+/** Queue handle. The queues' internals are private to this component. */
+typedef struct sSmeMpsc *ptSmeMpsc;
+
+/** One event in a queue slot; filled in place by the producer that reserved the slot. */
+typedef struct sSmeMpscEntry {
+	tEvQ_Event	ev;
+	uint32_t	extra;
+} tSmeMpscEntry, *ptSmeMpscEntry;
+
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+extern ptSmeMpsc Cwsw_Sme_Mpsc_Create(
+	ptSmePool	pPool,			// pool whose instances get a queue each
+	uint32_t	szQueue);		// capacity in events of each queue; must be a power of 2
+
+extern ptSmeMpscEntry Cwsw_Sme_Mpsc_Reserve(ptSmeMpsc pMpsc, tSmeInstance inst);
+extern void Cwsw_Sme_Mpsc_Commit(ptSmeMpsc pMpsc, ptSmeMpscEntry pEntry);
+extern bool Cwsw_Sme_Mpsc_Post(ptSmeMpsc pMpsc, tSmeInstance inst, tEvQ_Event ev, uint32_t extra);
+
+extern ptSmeMpscEntry Cwsw_Sme_Mpsc_Peek(ptSmeMpsc pMpsc, tSmeInstance inst);
+extern void Cwsw_Sme_Mpsc_Release(ptSmeMpsc pMpsc, tSmeInstance inst);
+extern bool Cwsw_Sme_Mpsc_IsEmpty(ptSmeMpsc pMpsc, tSmeInstance inst);
+
+extern uint32_t Cwsw_Sme_Mpsc_Drain(ptSmeMpsc pMpsc, tSmeInstance inst, uint32_t maxevents);
+extern uint32_t Cwsw_Sme_Mpsc_DrainPool(ptSmeMpsc pMpsc, uint32_t maxevents);
+
+extern uint64_t Cwsw_Sme_Mpsc_Rejected(ptSmeMpsc pMpsc);
+extern void Cwsw_Sme_Mpsc_Destroy(ptSmeMpsc pMpsc);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* SME_MPSC_H */
@@ -0,0 +1,116 @@
+/** @file
+ *	@brief	Deterministic, faster-than-real-time replay of scripted button input into an SME.
+ *
+ *	The script is the textual input format from the design notes: a time value, then a string of
+ *	contact samples, then another time value, then more samples, and so on. Within a string, `1`
+ *	through `9` are button 1 through button 9 closed, and `0` is the button released; a bouncing
+ *	contact is simply a string that alternates, such as `1101011111`.
+ *
+ *	Precisely:
+ *	- tokens are separated by whitespace; `#` starts a comment that runs to the end of the line;
+ *	- tokens alternate between a time value and a contact string, starting with a time value;
+ *	- a time value is the delay, in clock tics, from the end of the previous string to the first
+ *	  sample of the next. It is binary, as in the design notes, so `101` is 5 tics; `0b` may prefix
+ *	  it. As extensions, `0d` prefixes a decimal value and `0x` a hexadecimal one;
+ *	- each sample of a string holds for `sample` tics.
+ *
+ *	Instead of Cwsw_Clock and the software alarms, the replay keeps a virtual clock, which jumps
+ *	straight from one sample to the next. Along the way it calls the periodic tick that stands in
+ *	for the SME's driving alarm, exactly as often as the alarm would have matured, and advances
+ *	the timing wheel, if one is given. The result is the same sequence of SME steps as in real
+ *	time, run as fast as the machines can take them.
+ *
+ *	As a regression oracle, the replay folds whatever the project chooses to record (states
+ *	entered, outputs driven) into a digest; the same script must always produce the same digest.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef SME_REPLAY_H
+#define SME_REPLAY_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme.h"
+#include "cwsw_sme_wheel.h"
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants and Type Definitions ----------------------------------------
+// ============================================================================
+
+/** Longest time value accepted, in characters, including any prefix. */
+#define SME_REPLAY_MAXTOKEN		(40)
+
+/** Delivery of one contact sample: 0 for released, 1 through 9 for that button closed. */
+typedef void (*pfSmeReplayInput)(void *pCtx, tCwswClockTics now, uint8_t contact);
+
+/** The periodic tick that stands in for the SME's driving alarm. */
+typedef void (*pfSmeReplayTick)(void *pCtx, tCwswClockTics now);
+
+/** One replay.
+ *	The caller fills in the fields up to and including `sample`; Cwsw_Sme_Replay_Init() sets the
+ *	rest.
+ */
+typedef struct sSmeReplay {
+	pfSmeReplayInput	pfInput;	// receives each contact sample
+	pfSmeReplayTick		pfTick;		// optional; called every `period` tics
+	void				*pCtx;		// passed to pfInput and pfTick
+	ptSmeWheel			pWheel;		// optional; advanced along with the virtual clock
+	tCwswClockTics		period;		// period of pfTick, in tics; 0 for no tick
+	tCwswClockTics		sample;		// duration of each contact sample, in tics; at least 1
+
+	tCwswClockTics		now;		// virtual clock
+	tCwswClockTics		nexttick;	// time of the next call to pfTick
+	uint64_t			digest;		// FNV-1a digest of everything recorded
+	uint64_t			samples;	// contact samples delivered
+	uint64_t			ticks;		// ticks delivered
+	uint32_t			errors;		// characters or tokens that could not be used
+	uint32_t			line;		// current line of the script, from 1
+
+	// parser state, kept between calls so a script can be fed in pieces of any size
+	bool				wanttime;	// the next token is a time value
+	bool				intoken;	// within a token
+	bool				incomment;	// within a comment
+	uint32_t			toklen;		// characters held in `token`
+	char				token[SME_REPLAY_MAXTOKEN];
+} tSmeReplay, *ptSmeReplay;
+
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+extern bool Cwsw_Sme_Replay_Init(ptSmeReplay pReplay, tCwswClockTics start);
+extern size_t Cwsw_Sme_Replay_Feed(ptSmeReplay pReplay, char const *pText, size_t len);
+extern void Cwsw_Sme_Replay_Finish(ptSmeReplay pReplay);
+extern bool Cwsw_Sme_Replay_File(ptSmeReplay pReplay, char const *path);
+
+extern tCwswClockTics Cwsw_Sme_Replay_Clock(void);
+extern void Cwsw_Sme_Replay_Record(ptSmeReplay pReplay, void const *pData, size_t len);
+extern uint64_t Cwsw_Sme_Replay_Digest(ptSmeReplay pReplay);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* SME_REPLAY_H */
@@ -0,0 +1,85 @@
+/** @file
+ *	@brief	Host-side, multi-threaded scheduler for pools of SME instances.
+ *
+ *	The SME's design intent is that one dispatcher calls each state machine from its alarm. When a
+ *	pool holds thousands of independent instances, this scheduler spreads them across worker
+ *	threads instead:
+ *	- each instance has its own inbox, a lock-free queue from cwsw_sme_mpsc.h; events posted to an
+ *	  instance are run in the order posted;
+ *	- an instance with pending events is placed on the run queue of its home worker;
+ *	- a worker with an empty run queue steals work from the others;
+ *	- an instance is never on more than one run queue, and never runs on two threads at once.
+ *
+ *	@note This component is intended for POSIX hosts; it requires C11 atomics and POSIX threads,
+ *	and allocates its working storage at creation. The transition trace ring has a single writer,
+ *	so leave CWSW_SME_TRACE off when using the scheduler.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef SME_SCHED_H
+#define SME_SCHED_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdbool.h>
+#include <stdint.h>
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme.h"
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants and Type Definitions ----------------------------------------
+// ============================================================================
+
+/** Maximum number of events an instance runs before yielding its worker to other instances. */
+#if !defined(CWSW_SME_SCHED_BUDGET)
+#define CWSW_SME_SCHED_BUDGET	(32)
+#endif
+
+/** Scheduler handle. The scheduler's internals are private to the scheduler. */
+typedef struct sSmeSched *ptSmeSched;
+
+/** Scheduler counters, as reported by Cwsw_Sme_Sched_Stats(). */
+typedef struct sSmeSchedStats {
+	uint64_t	events;		// events run
+	uint64_t	runs;		// times an instance was taken from a run queue
+	uint64_t	steals;		// runs that were stolen from another worker's run queue
+	uint64_t	rejected;	// posts refused because the instance's inbox was full
+} tSmeSchedStats, *ptSmeSchedStats;
+
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+extern ptSmeSched Cwsw_Sme_Sched_Create(
+	ptSmePool	pPool,			// pool whose instances are to be scheduled
+	uint32_t	nWorkers,		// number of worker threads
+	uint32_t	szInbox);		// capacity in events of each instance's inbox; must be a power of 2
+
+extern bool Cwsw_Sme_Sched_Post(ptSmeSched pSched, tSmeInstance inst, tEvQ_Event ev, uint32_t extra);
+extern void Cwsw_Sme_Sched_Drain(ptSmeSched pSched);
+extern void Cwsw_Sme_Sched_Stats(ptSmeSched pSched, ptSmeSchedStats pStats);
+extern void Cwsw_Sme_Sched_Destroy(ptSmeSched pSched);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* SME_SCHED_H */
@@ -0,0 +1,112 @@
+/** @file
+ *	@brief	Snapshot and restore of a pool of SME instances, for warm restart.
+ *
+ *	A pool already keeps everything an instance-aware machine knows in its per-instance arrays:
+ *	current state, state phase, state timer, saved exit reason, application data, and (with a
+ *	timing wheel) the pending state timeout. A snapshot writes those arrays into one compact binary
+ *	image; a restore reads them back in bulk, column by column, with no events replayed.
+ *
+ *	The image holds no pointers. States are written as their position in a state list supplied
+ *	by the project, which must list every state the machines can be in, in the same order at save
+ *	and at restore (the state enumeration is the natural order). Times are written relative to the
+ *	`now` given at save, and restored relative to the `now` given at restore, so timers survive a
+ *	restart of the clock.
+ *
+ *	Image layout, in the host's native byte order (an image is not portable between hosts of
+ *	different endianness):
+ *	- header, tSmeSnapshotHeader;
+ *	- state timers, time left: int32_t per instance;
+ *	- saved exit reasons: uint32_t per instance;
+ *	- with a wheel: timeouts, time left (0 if not armed): int32_t per instance;
+ *	- with a wheel: timeout events: uint32_t per instance;
+ *	- current states, as indices into the state list: uint16_t per instance;
+ *	- state phases: uint8_t per instance;
+ *	- application data: `szUser` bytes per instance, in one block.
+ *
+ *	Function-static variables in plain (not instance-aware) state handlers are out of sight of the
+ *	engine, and are not captured.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef SME_SNAPSHOT_H
+#define SME_SNAPSHOT_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme.h"
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants and Type Definitions ----------------------------------------
+// ============================================================================
+
+/** Identifies a snapshot image: "SMEP". */
+#define SME_SNAPSHOT_MAGIC		(0x504D4553u)
+
+/** Version of the image layout. */
+#define SME_SNAPSHOT_VERSION	(1u)
+
+/** Image flags. */
+enum eSmeSnapshotFlags {
+	kSmeSnapshot_Wheel	= 0x0001	//!< the image holds the timing wheel's timeouts
+};
+
+/** Header of a snapshot image. */
+typedef struct sSmeSnapshotHeader {
+	uint32_t	magic;		// SME_SNAPSHOT_MAGIC
+	uint16_t	version;	// SME_SNAPSHOT_VERSION
+	uint16_t	flags;		// kSmeSnapshot_xxx
+	uint32_t	count;		// instances in the image
+	uint32_t	nStates;	// length of the state list the image was written with
+	uint32_t	szUser;		// bytes of application data per instance
+	uint32_t	checksum;	// FNV-1a of everything after the header
+} tSmeSnapshotHeader;
+
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+extern size_t Cwsw_Sme_Snapshot_Size(ptSmePool pPool);
+
+extern size_t Cwsw_Sme_Snapshot_Save(
+	ptSmePool				pPool,			// pool to save
+	pfStateHandler const	*pStates,		// every state the instances can be in
+	uint32_t				nStates,		// elements in pStates; at most 65535
+	tCwswClockTics			now,			// current time; timers are saved relative to it
+	void					*pImage,		// caller-provided storage for the image
+	size_t					szImage);		// size in bytes of pImage
+
+extern bool Cwsw_Sme_Snapshot_Restore(
+	ptSmePool				pPool,			// initialized pool to restore into; its instances are replaced
+	pfStateHandler const	*pStates,		// the state list the image was written with
+	uint32_t				nStates,		// elements in pStates
+	tCwswClockTics			now,			// current time; timers are restored relative to it
+	void const				*pImage,		// image written by Cwsw_Sme_Snapshot_Save()
+	size_t					szImage);		// size in bytes of the image
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* SME_SNAPSHOT_H */
@@ -0,0 +1,133 @@
+/** @file
+ *	@brief	Timeout service for pools of SME instances, built on a hashed timing wheel.
+ *
+ *	A timed state in the template arms a tCwswClockTics timer on entry, then polls it on every SME
+ *	tick; the handler runs only to learn that nothing has happened yet. Here, a state arms its
+ *	instance's timeout with the wheel instead, and the wheel posts a timeout event to the instance
+ *	when, and only when, the timeout expires. Arm, cancel and expire are O(1).
+ *
+ *	Each instance of the pool has one timeout, the state timeout. The wheel has `nSlots` slots, each
+ *	the head of a list of the timeouts whose deadline falls in that slot; a deadline more than one
+ *	revolution away simply stays in its slot until its revolution comes around.
+ *
+ *	The wheel also knows the earliest pending deadline, so the alarm that drives the SME need not be
+ *	periodic: in tickless mode (tSmeTickless), the alarm is re-armed for exactly that deadline, and
+ *	kicked when an event is posted, so an idle SME does not wake at all.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef SME_WHEEL_H
+#define SME_WHEEL_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdbool.h>
+#include <stdint.h>
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme.h"
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants and Type Definitions ----------------------------------------
+// ============================================================================
+
+/** Adapter to the project's software-alarm component, for the tickless driver.
+ *	The driver needs exactly two operations on the alarm that drives the SME:
+ *	- CWSW_SME_ALARM_ARM(pAlarm, delay): arm it as a one-shot, maturing `delay` tics from now; a
+ *	  delay of 0 means "on the next pass of the alarm manager";
+ *	- CWSW_SME_ALARM_DISARM(pAlarm): disarm it.
+ *
+ *	Nothing else in this component touches a tCwswSwAlarm. Unless the project defines both, the
+ *	wheel's own default is used, which writes the alarm's fields directly, and assumes that the
+ *	alarm manager counts `tm` down to 0, matures the alarm at 0, reloads it from `reloadtm` only if
+ *	that is nonzero, and skips it while `tmrstate` is kTmrState_Disabled. A project whose swtimer
+ *	component works otherwise, or that prefers to go through its API (Cwsw_SwAlarm__Init() and
+ *	friends), defines these two instead.
+ */
+#if defined(CWSW_SME_ALARM_ARM) != defined(CWSW_SME_ALARM_DISARM)
+#error "define both CWSW_SME_ALARM_ARM() and CWSW_SME_ALARM_DISARM(), or neither"
+#endif
+
+/** Delivery of an expired timeout.
+ *	Same signature as Cwsw_Sme__SMEInst(), which is what the wheel uses if none is given; supply
+ *	another to post the timeout through a queue or a scheduler instead of running the instance
+ *	immediately.
+ */
+typedef pfStateHandler (*pfSmeWheelExpiry)(ptSmePool pPool, tSmeInstance inst, tEvQ_Event ev, uint32_t extra);
+
+/** Timing wheel for the state timeouts of one instance pool.
+ *	The arrays are provided by the caller: `pSlots` holds `nSlots` elements, a power of 2; the
+ *	per-instance arrays each hold the pool's `capacity` elements.
+ *
+ *	A wheel has no lock. It, and the pool it serves, belong to one thread: every call on the wheel,
+ *	including the arm and cancel of the pool's state handlers, must be made on the thread that
+ *	advances it. A pool with a wheel is therefore not run on the scheduler (cwsw_sme_sched.h), whose
+ *	workers run handlers on several threads; Cwsw_Sme_Sched_Create() refuses one.
+ */
+typedef struct sSmeWheel {
+	ptSmePool			pPool;		// pool whose instances own the timeouts
+	pfSmeWheelExpiry	pfExpiry;	// optional; delivers expired timeouts
+	uint32_t			nSlots;		// number of slots; a power of 2
+	tSmeInstance		*pSlots;	// first timeout in each slot
+	tSmeInstance		*pNext;		// next timeout in the same slot
+	tSmeInstance		*pPrev;		// previous timeout in the same slot
+	tCwswClockTics		*pDeadline;	// absolute expiry time
+	tEvQ_EventID		*pEvId;		// event posted upon expiry
+	tCwswClockTics		now;		// time up to which the wheel has been advanced
+	uint32_t			nArmed;		// number of armed timeouts
+	tSmeInstance		expiring;	// expired timeouts not yet delivered, linked through pNext
+} tSmeWheel, *ptSmeWheel;
+
+/** Tickless driver for the alarm that runs an SME.
+ *	Instead of a fixed-period alarm that wakes every machine every period, the driving alarm is
+ *	re-armed, as a one-shot, for exactly the earliest pending deadline on the wheel; and it is
+ *	matured at once when an event is posted for the SME.
+ */
+typedef struct sSmeTickless {
+	ptCwswSwAlarm	pAlarm;		// alarm that drives the SME's task
+	ptSmeWheel		pWheel;		// wheel holding the SME's pending deadlines
+	tCwswClockTics	maxsleep;	// longest the alarm is armed for; 0 to disable it when nothing is pending
+	tCwswClockTics	deadline;	// deadline the alarm is armed for, if `armed`
+	bool			armed;		// the alarm is armed
+	uint32_t		rearms;		// times the alarm was re-armed for a deadline
+	uint32_t		kicks;		// times the alarm was matured for a posted event
+} tSmeTickless, *ptSmeTickless;
+
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+extern bool Cwsw_Sme_Wheel_Init(ptSmeWheel pWheel, tCwswClockTics now);
+extern void Cwsw_Sme_Wheel_Arm(ptSmeWheel pWheel, tSmeInstance inst, tCwswClockTics delay, tEvQ_EventID evId);
+extern void Cwsw_Sme_Wheel_Cancel(ptSmeWheel pWheel, tSmeInstance inst);
+extern bool Cwsw_Sme_Wheel_IsArmed(ptSmeWheel pWheel, tSmeInstance inst);
+extern tCwswClockTics Cwsw_Sme_Wheel_TimeLeft(ptSmeWheel pWheel, tSmeInstance inst);
+extern uint32_t Cwsw_Sme_Wheel_Advance(ptSmeWheel pWheel, tCwswClockTics now);
+extern bool Cwsw_Sme_Wheel_NextDeadline(ptSmeWheel pWheel, tCwswClockTics *pDeadline);
+
+extern uint32_t Cwsw_Sme_Tickless_Service(ptSmeTickless pDrv, tCwswClockTics now);
+extern void Cwsw_Sme_Tickless_Rearm(ptSmeTickless pDrv);
+extern void Cwsw_Sme_Tickless_Kick(ptSmeTickless pDrv);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* SME_WHEEL_H */
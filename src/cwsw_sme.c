@@ -13,21 +13,128 @@
 // ============================================================================
 
 // ----	System Headers --------------------------
+#include <stdlib.h>		/* qsort() */
+#include <string.h>		/* memcpy(), memset() */
 
 // ----	Project Headers -------------------------
 
 // ----	Module Headers --------------------------
 #include "cwsw_sme.h"
 
+// ----	System Headers, per configuration -------
+// (after the module header, which supplies the configuration defaults)
+#if (CWSW_SME_TRACE)
+#include <stdio.h>			/* snprintf() */
+#include <inttypes.h>		/* PRIxPTR */
+#endif
+#if (CWSW_SME_SIMD) && defined(__AVX2__)
+#include <immintrin.h>		/* AVX2 structure-of-arrays kernel */
+#elif (CWSW_SME_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>		/* SSE2 structure-of-arrays kernel */
+#endif
+
 
 // ============================================================================
 // ----	Constants -------------------------------------------------------------
 // ============================================================================
 
+#if (CWSW_SME_TRACE)
+#if (CWSW_SME_TRACE_DEPTH & (CWSW_SME_TRACE_DEPTH - 1))
+#error "CWSW_SME_TRACE_DEPTH must be a power of 2"
+#endif
+#define TRACE_MASK		(CWSW_SME_TRACE_DEPTH - 1)
+
+/* the ring's indices publish the records: the writer stores a record, then releases the head past
+ * it; the reader acquires the head before it copies, then releases the tail once it's done. without
+ * the GNU builtins, the target is assumed to have one core, where volatile access is enough.
+ */
+#if defined(__GNUC__)
+#define TRACE_ACQUIRE(x)		__atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define TRACE_RELEASE(x, v)		__atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#define TRACE_LOAD(x)			__atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define TRACE_STORE(x, v)		__atomic_store_n(&(x), (v), __ATOMIC_RELAXED)
+#else
+#define TRACE_ACQUIRE(x)		(*(uint32_t volatile *)&(x))
+#define TRACE_RELEASE(x, v)		(*(uint32_t volatile *)&(x) = (v))
+#define TRACE_LOAD(x)			(*(uint32_t volatile *)&(x))
+#define TRACE_STORE(x, v)		(*(uint32_t volatile *)&(x) = (v))
+#endif
+#endif
+
+#if (CWSW_SME_STATS)
+/* each statistics block has one writer, its thread, so a counter is bumped with a plain load and
+ * store; the accesses are atomic only so that a snapshot, taken from another thread, never sees a
+ * torn value.
+ */
+#if defined(__GNUC__)
+#define STATS_LOAD(x)			__atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define STATS_STORE(x, v)		__atomic_store_n(&(x), (v), __ATOMIC_RELAXED)
+#else
+#define STATS_LOAD(x)			(*(uint32_t volatile *)&(x))
+#define STATS_STORE(x, v)		(*(uint32_t volatile *)&(x) = (v))
+#endif
+#define STATS_BUMP(x)			STATS_STORE(x, STATS_LOAD(x) + 1)
+
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_THREADS__)
+#define SME_THREAD_LOCAL		_Thread_local
+#elif defined(__GNUC__)
+#define SME_THREAD_LOCAL		__thread
+#else
+#define SME_THREAD_LOCAL		/* no threads on this target */
+#endif
+#endif
+
+/* the interest counters belong to the interest sets, which are shared by every instance of a pool,
+ * and a pool's instances may be stepped on several threads at once (cwsw_sme_sched.h). they are
+ * only statistics, so a relaxed atomic increment is enough.
+ */
+#if defined(__GNUC__)
+#define INTEREST_COUNT(x)		(void)__atomic_fetch_add(&(x), 1u, __ATOMIC_RELAXED)
+#else
+#define INTEREST_COUNT(x)		(void)++(x)
+#endif
+
+/** Rows compared at once by the structure-of-arrays kernel. */
+#if (CWSW_SME_SIMD) && defined(__AVX2__)
+#define SOA_LANES		(8)
+#elif (CWSW_SME_SIMD) && defined(__SSE2__)
+#define SOA_LANES		(4)
+#else
+#define SOA_LANES		(1)
+#endif
+
 // ============================================================================
 // ----	Type Definitions ------------------------------------------------------
 // ============================================================================
 
+/** Search key for a structure-of-arrays table: the current state and exit reasons, as columns. */
+typedef struct sSmeSoaKey {
+	uint32_t	state;		// low 32 bits
+	uint32_t	reason1;
+	uint32_t	reason2;
+	uint32_t	reason3;
+} tSmeSoaKey;
+
+/** Search key for a packed table.
+ *	Holds, for each resolved match mask, the first 8 bytes of a packed row (its reasons, its
+ *	current state and its next state) as they would be in a row with that mask that matches; see
+ *	PackedKey().
+ */
+typedef struct sSmePackedKey {
+	uint64_t	fields;		// the bytes compared: all but the next state's
+	uint64_t	expect[8];	// indexed by match mask
+} tSmePackedKey;
+
+/** Everything the engine needs to drive one machine, whichever entry point it came through. */
+typedef struct sSmeMachine {
+	ptTransitionTable		pTbl;		// transition table
+	uint32_t				szTbl;		// size in rows of the transition table
+	ptSmeTransitionIndex	pIndex;		// compiled table; if set, used instead of pTbl
+	ptSmeHsm				pHsm;		// flattened hierarchy; if set, used instead of pTbl and pIndex
+	ptSmePool				pPool;		// if set, the states are instance-aware, and belong to `inst`
+	tSmeInstance			inst;		// instance being driven
+} tSmeMachine;
+
 // ============================================================================
 // ----	Global Variables ------------------------------------------------------
 // ============================================================================
@@ -36,83 +143,2018 @@
 // ----	Module-level Variables ------------------------------------------------
 // ============================================================================
 
+static pfSmeTimeSource pfSmeNow = NULL;
+
+#if (CWSW_SME_STATS)
+static SME_THREAD_LOCAL ptSmeStats	pStatsSel = NULL;	// this thread's statistics block
+static SME_THREAD_LOCAL tCwswClockTics	*pStatsPlain = NULL;	// entry time of the plain machine this thread steps
+static SME_THREAD_LOCAL tCwswClockTics	*pStatsEntered = NULL;	// entry time of the machine being stepped
+#endif
+
+#if (CWSW_SME_TRACE)
+/* the trace ring has one writer (the SME) and one reader (the drain API). the writer owns the head
+ * and the reader owns the tail; when the ring is full, the newest record is dropped and counted,
+ * so the writer never touches the tail.
+ */
+static tSmeTraceRecord	tracering[CWSW_SME_TRACE_DEPTH];
+static uint32_t			tracehead = 0;
+static uint32_t			tracetail = 0;
+static uint32_t			tracelost = 0;
+#endif
+
 // ============================================================================
 // ----	Private Functions -----------------------------------------------------
 // ============================================================================
 
-// ============================================================================
-// ----	Public Functions ------------------------------------------------------
-// ============================================================================
+/** Reasons compared by a row with the given match mask. */
+static uint32_t
+MatchMask(uint8_t match)
+{
+	if(match == kSmeMatch_Default)	{ return kSmeMatch_Reason1 | kSmeMatch_Reason3; }
+	return match & (kSmeMatch_Reason1 | kSmeMatch_Reason2 | kSmeMatch_Reason3);
+}
 
-/** Search for the next state.
- *	If found, execute transition function, if any specified.
+/** Reasons compared for one row of the transition table. */
+static uint32_t
+RowMatchMask(ptTransitionTable pRow)
+{
+	return MatchMask(pRow->match);
+}
+
+/** Is a row, already known to be for the current state, eligible?
+ *	The reasons named by the row's match mask are compared first; only if they all match is the
+ *	row's guard, if any, called.
  */
-pfStateHandler
-Cwsw_Sme_FindNextState(
-	ptTransitionTable	pTblTransition,		// 1st row of transition table
-	uint32_t			szTblTransition,	// size in rows of transition table
+static bool
+RowMatches(ptTransitionTable pRow, tEvQ_Event ev, uint32_t extra)
+{
+	uint32_t match = RowMatchMask(pRow);
+
+	if((match & kSmeMatch_Reason1) && (pRow->reason1 != (uint32_t)ev.evId))	{ return false; }
+	if((match & kSmeMatch_Reason2) && (pRow->reason2 != ev.evData))			{ return false; }
+	if((match & kSmeMatch_Reason3) && (pRow->reason3 != extra))				{ return false; }
+	if(pRow->pfGuard && !pRow->pfGuard(ev, extra))							{ return false; }
+	return true;
+}
+
+/** Linear search of the transition table.
+ *	The table is walked from the last row to the first, so that when more than one row is eligible,
+ *	the last one wins.
+ *
+ *	@returns The selected row, or szTblTransition if there is none.
+ */
+static uint32_t
+FindRow(
+	ptTransitionTable	pTblTransition,
+	uint32_t			szTblTransition,
 	pfStateHandler		currentstate,
-	tEvQ_Event			ev, 				// 1st two exit reasons
-	uint32_t 			extra)				// 3rd exit reason
+	tEvQ_Event			ev,
+	uint32_t 			extra)
 {
-	pfStateHandler nextstate = currentstate;
 	uint32_t tblidx = szTblTransition;
 	while(tblidx--)
 	{
 		if(pTblTransition[tblidx].pfCurrent == currentstate)
 		{
-			if(pTblTransition[tblidx].reason1 == ev.evId)
+			if(RowMatches(&pTblTransition[tblidx], ev, extra))
 			{
-				// this might a domain-specific edit; in the button-reading component, we're using
-				//	the evData field (reason2) to represent the button being acted upon, and we have
-				//	enough resolution available in the reason3 field, so we don't need to use the
-				//	`reason2` comparison.
-			//	if(pTblTransition[tblidx].reason2 == ev.evData)
-				{
-					if(pTblTransition[tblidx].reason3 == extra)
-					{
-						nextstate = pTblTransition[tblidx].pfNext;
-						if(pTblTransition[tblidx].pfTransition)
-						{
-							(void)printf("Transition %i selected\n", tblidx);
-							pTblTransition[tblidx].pfTransition(ev, extra);
-						}
-						break;
-					}	// reason3
-				}		// reason2 - ignored since reason2 now carries the button
-			}			// reason1
+				return tblidx;
+			}
 		}
 	}
+	return szTblTransition;
+}
 
-	return nextstate;
+#if (CWSW_SME_TRACE)
+/** Append one record to the transition trace ring. */
+static void
+TraceRecord(pfStateHandler pfFrom, pfStateHandler pfTo, uint32_t tblidx, tEvQ_Event ev, uint32_t extra)
+{
+	uint32_t head = TRACE_LOAD(tracehead);
+	ptSmeTraceRecord pRec;
+
+	// the slot past the tail is free only once the reader has finished copying out of it.
+	if((head - TRACE_ACQUIRE(tracetail)) >= CWSW_SME_TRACE_DEPTH)
+	{
+		TRACE_STORE(tracelost, TRACE_LOAD(tracelost) + 1);
+		return;
+	}
+
+	pRec = &tracering[head & TRACE_MASK];
+	pRec->timestamp	= pfSmeNow ? pfSmeNow() : 0;
+	pRec->row		= tblidx;
+	pRec->pfFrom	= pfFrom;
+	pRec->pfTo		= pfTo;
+	pRec->evId		= ev.evId;
+	pRec->evData	= ev.evData;
+	pRec->extra		= extra;
+	TRACE_RELEASE(tracehead, head + 1);	// publish the record only once it's complete
+}
+#define TRACE_RECORD(from, to, idx, ev, extra)	TraceRecord(from, to, idx, ev, extra)
+#else
+#define TRACE_RECORD(from, to, idx, ev, extra)	(void)(idx)
+#endif
+
+#if (CWSW_SME_STATS)
+/** Histogram bucket for a duration. */
+static uint32_t
+StatsBucket(tCwswClockTics duration)
+{
+	uint32_t tics = (duration > 0) ? (uint32_t)duration : 0;
+	uint32_t bucket = 0;
+
+	while(tics && (bucket < (SME_STATS_BUCKETS - 1)))
+	{
+		tics >>= 1;
+		++bucket;
+	}
+	return bucket;
 }
 
+/** Position of a state in the statistics block's state list; nStates if it isn't tracked. */
+static uint32_t
+StatsState(ptSmeStats pStats, pfStateHandler state)
+{
+	uint32_t idx;
 
-/** CWSW State Machine Engine task.
- *	This is the core SM Engine. It is intended to be called from the SME of a specific state machine.
+	for(idx = 0; (idx < pStats->nStates) && (pStats->pStates[idx] != state); ++idx)	{ }
+	return idx;
+}
+
+/** Count a selected row: the row's hit, the exited state's dwell time, and the entered state's entry. */
+static void
+StatsRow(pfStateHandler pfFrom, pfStateHandler pfTo, uint32_t rowidx)
+{
+	ptSmeStats pStats = pStatsSel;
+	uint32_t from;
+	uint32_t to;
+
+	if(!pStats)	{ return; }
+
+	if(pStats->pRowHits && (rowidx < pStats->szRows))	{ STATS_BUMP(pStats->pRowHits[rowidx]); }
+	if(!pStats->pStates)								{ return; }
+
+	from = StatsState(pStats, pfFrom);
+	to   = StatsState(pStats, pfTo);
+	if(pStatsEntered && pfSmeNow)
+	{
+		tCwswClockTics now = pfSmeNow();
+		if(pStats->pDwell && (from < pStats->nStates))
+		{
+			STATS_BUMP(pStats->pDwell[(from * SME_STATS_BUCKETS) + StatsBucket(now - *pStatsEntered)]);
+		}
+		*pStatsEntered = now;
+	}
+	if(pStats->pEntries && (to < pStats->nStates))	{ STATS_BUMP(pStats->pEntries[to]); }
+}
+
+static void
+StatsMiss(void)
+{
+	if(pStatsSel)	{ STATS_BUMP(pStatsSel->misses); }
+}
+
+/** Start timing a step of the given machine. @returns The start time. */
+static tCwswClockTics
+StatsStepBegin(tSmeMachine const *pm)
+{
+	/* the entry time belongs to the machine, not to the thread: a pool instance may be stepped on
+	 * a different thread each time, and a thread may step several plain machines.
+	 */
+	if(pm && pm->pPool)	{ pStatsEntered = pm->pPool->pEntered ? &pm->pPool->pEntered[pm->inst] : NULL; }
+	else				{ pStatsEntered = pStatsPlain; }
+	return (pStatsSel && pfSmeNow) ? pfSmeNow() : 0;
+}
+
+/** Finish timing a step. @returns The end time, which is also the start of the step after it. */
+static tCwswClockTics
+StatsStepEnd(tCwswClockTics start)
+{
+	ptSmeStats pStats = pStatsSel;
+	tCwswClockTics now;
+
+	if(!pStats)		{ return 0; }
+
+	STATS_BUMP(pStats->steps);
+	if(!pfSmeNow)	{ return 0; }
+
+	now = pfSmeNow();
+	STATS_BUMP(pStats->latency[StatsBucket(now - start)]);
+	return now;
+}
+
+#define STATS_ROW(from, to, idx)	StatsRow(from, to, idx)
+#define STATS_MISS()				StatsMiss()
+#define STATS_STEP_BEGIN(pm)		tCwswClockTics const statsstart = StatsStepBegin(pm)
+#define STATS_STEP_END()			(void)StatsStepEnd(statsstart)
+#define STATS_BATCH_BEGIN(pm)		tCwswClockTics statsstart = StatsStepBegin(pm)
+#define STATS_BATCH_STEP()			statsstart = StatsStepEnd(statsstart)
+#else
+#define STATS_ROW(from, to, idx)	(void)0
+#define STATS_MISS()				(void)0
+#define STATS_STEP_BEGIN(pm)		(void)0
+#define STATS_STEP_END()			(void)0
+#define STATS_BATCH_BEGIN(pm)		(void)0
+#define STATS_BATCH_STEP()			(void)0
+#endif
+
+/** Take the transition described by one row of the transition table.
+ *	@returns The next state named by the row.
+ */
+static pfStateHandler
+TakeRow(ptTransitionTable pRow, uint32_t tblidx, tEvQ_Event ev, uint32_t extra)
+{
+	TRACE_RECORD(pRow->pfCurrent, pRow->pfNext, tblidx, ev, extra);
+	STATS_ROW(pRow->pfCurrent, pRow->pfNext, tblidx);
+	if(pRow->pfTransition)
+	{
+		pRow->pfTransition(ev, extra);
+	}
+	return pRow->pfNext;
+}
+
+/** A packed row's first 8 bytes, as one word. The key is built as rows and read the same way, so
+ *	the comparison doesn't depend on byte order or on the row's layout.
+ */
+static uint64_t
+PackedRowFields(tSmePackedRow const *pRow)
+{
+	uint64_t fields;
+	memcpy(&fields, pRow, sizeof(fields));
+	return fields;
+}
+
+/** For each resolved match mask, the bytes of PackedRowFields() that it compares: the current
+ *	state always, and each reason it names.
+ */
+static tSmePackedRow const	packedmasks[8] = {
+	{ 0,          0,          0,          UINT8_MAX, 0, 0, 0, 0, 0 },
+	{ UINT16_MAX, 0,          0,          UINT8_MAX, 0, 0, 0, 0, 0 },
+	{ 0,          UINT16_MAX, 0,          UINT8_MAX, 0, 0, 0, 0, 0 },
+	{ UINT16_MAX, UINT16_MAX, 0,          UINT8_MAX, 0, 0, 0, 0, 0 },
+	{ 0,          0,          UINT16_MAX, UINT8_MAX, 0, 0, 0, 0, 0 },
+	{ UINT16_MAX, 0,          UINT16_MAX, UINT8_MAX, 0, 0, 0, 0, 0 },
+	{ 0,          UINT16_MAX, UINT16_MAX, UINT8_MAX, 0, 0, 0, 0, 0 },
+	{ UINT16_MAX, UINT16_MAX, UINT16_MAX, UINT8_MAX, 0, 0, 0, 0, 0 },
+};
+
+/** A next state, which is never among the compared bytes: a key that has it matches no row. */
+static tSmePackedRow const	packedunmatchable = { 0, 0, 0, 0, 1, 0, 0, 0, 0 };
+
+/** Rows holding 1 in one compared field each: reason1, reason2, reason3, current state. As words,
+ *	they place a value in its field by multiplication, whatever the byte order.
+ */
+static tSmePackedRow const	packedunits[4] = {
+	{ 1, 0, 0, 0, 0, 0, 0, 0, 0 },
+	{ 0, 1, 0, 0, 0, 0, 0, 0, 0 },
+	{ 0, 0, 1, 0, 0, 0, 0, 0, 0 },
+	{ 0, 0, 0, 1, 0, 0, 0, 0, 0 },
+};
+
+/** Build the search key for a packed table, once per search.
+ *	A row holds 0 in each reason it doesn't compare, so the key for each match mask is the event's
+ *	reasons and the current state, under that mask's bytes; a row matches when its compared bytes
+ *	equal the key for its mask. A reason too wide for 16 bits can't match, so the keys for the
+ *	masks that compare it are made unmatchable.
+ */
+static void
+PackedKey(tSmePackedKey *pkey, uint8_t currentstate, tEvQ_Event ev, uint32_t extra)
+{
+	uint64_t fields;
+	uint32_t wide;
+	uint32_t match;
+
+	wide =	  (((uint32_t)ev.evId > UINT16_MAX) ? kSmeMatch_Reason1 : 0)
+			| ((ev.evData > UINT16_MAX)		  ? kSmeMatch_Reason2 : 0)
+			| ((extra > UINT16_MAX)			  ? kSmeMatch_Reason3 : 0);
+
+	fields =  ((uint64_t)(uint16_t)ev.evId		* PackedRowFields(&packedunits[0]))
+			| ((uint64_t)(uint16_t)ev.evData	* PackedRowFields(&packedunits[1]))
+			| ((uint64_t)(uint16_t)extra		* PackedRowFields(&packedunits[2]))
+			| ((uint64_t)currentstate			* PackedRowFields(&packedunits[3]));
+
+	pkey->fields = PackedRowFields(&packedmasks[7]);
+	for(match = 0; match < 8; ++match)
+	{
+		pkey->expect[match] = fields & PackedRowFields(&packedmasks[match]);
+		if(match & wide)	{ pkey->expect[match] |= PackedRowFields(&packedunmatchable); }
+	}
+}
+
+/** Do a packed row's state and reasons match the key? Guards are not called.
+ *	Same rules as RowMatches(), compared all at once in the row's 16-bit form.
+ */
+static bool
+PackedRowMatches(tSmePackedRow const *pRow, tSmePackedKey const *pkey)
+{
+	return ((PackedRowFields(pRow) & pkey->fields) == pkey->expect[pRow->match & 7u]);
+}
+
+/** Search of a packed table: the current state's rows, from last to first.
+ *	The rows above the last whole block of 4 are compared one at a time; the rest, 4 at a time, with
+ *	one branch per block, taking the matching rows of each block from the highest down, so the last
+ *	eligible row wins.
  *
- *	@param[in] pTblTransitions 	The transition table of the calling SM.
- *	@param[in] sztbl 			Size of the caller's transition table.
- *	@param[in] CurrentState 	The current state.
- *	@param[in] ev 				Event parameter passed to the calling SME by the event dispatcher.
- *	@param[in] extra 			Extra parameter passed to the calling SME by the event dispatcher.
+ *	@returns The selected row, or nRows if there is none.
+ */
+static uint32_t
+FindPackedRow(tSmePackedTable const *pPacked, uint8_t currentstate, tEvQ_Event ev, uint32_t extra)
+{
+	tSmePackedRow const *pRows = pPacked->pRows;
+	uint32_t first = 0;
+	uint32_t rowidx = pPacked->nRows;
+	tSmePackedKey key;
+
+	if(pPacked->pFirst)
+	{
+		if(currentstate >= pPacked->nStates)	{ return pPacked->nRows; }
+		first  = pPacked->pFirst[currentstate];
+		rowidx = pPacked->pFirst[currentstate + 1];
+	}
+	PackedKey(&key, currentstate, ev, extra);
+
+	while(rowidx > first)
+	{
+		tSmePackedRow const *pRow = &pRows[--rowidx];
+		if(PackedRowMatches(pRow, &key))
+		{
+			if(!pRow->guard || pPacked->pGuards[pRow->guard](ev, extra))	{ return rowidx; }
+		}
+	}
+	return pPacked->nRows;
+}
+
+/** Compare one row of a structure-of-arrays table; the portable kernel. */
+static bool
+SoaMatchRow(ptSmeSoaTable pSoa, uint32_t row, tSmeSoaKey const *pkey)
+{
+	uint32_t diff;
+
+	diff  = (pSoa->pState[row] ^ pkey->state);
+	diff |= (pSoa->pReason1[row] ^ pkey->reason1) & pSoa->pMask1[row];
+	diff |= (pSoa->pReason2[row] ^ pkey->reason2) & pSoa->pMask2[row];
+	diff |= (pSoa->pReason3[row] ^ pkey->reason3) & pSoa->pMask3[row];
+	return (diff == 0);
+}
+
+/** Compare the rows `row` through `row + SOA_LANES - 1` of a structure-of-arrays table.
+ *	@returns A bit per row, bit 0 for `row`, set if the row's fields match; guards are not called.
+ */
+#if (SOA_LANES == 8)
+static uint32_t
+SoaMatchBlock(ptSmeSoaTable pSoa, uint32_t row, tSmeSoaKey const *pkey)
+{
+	#define SOA_LOAD(col)	_mm256_loadu_si256((__m256i const *)&(col)[row])
+	#define SOA_KEY(fld)	_mm256_set1_epi32((int)pkey->fld)
+	__m256i diff;
+
+	diff = _mm256_xor_si256(SOA_LOAD(pSoa->pState), SOA_KEY(state));
+	diff = _mm256_or_si256(diff, _mm256_and_si256(_mm256_xor_si256(SOA_LOAD(pSoa->pReason1), SOA_KEY(reason1)), SOA_LOAD(pSoa->pMask1)));
+	diff = _mm256_or_si256(diff, _mm256_and_si256(_mm256_xor_si256(SOA_LOAD(pSoa->pReason2), SOA_KEY(reason2)), SOA_LOAD(pSoa->pMask2)));
+	diff = _mm256_or_si256(diff, _mm256_and_si256(_mm256_xor_si256(SOA_LOAD(pSoa->pReason3), SOA_KEY(reason3)), SOA_LOAD(pSoa->pMask3)));
+	return (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(diff, _mm256_setzero_si256())));
+	#undef SOA_LOAD
+	#undef SOA_KEY
+}
+#elif (SOA_LANES == 4)
+static uint32_t
+SoaMatchBlock(ptSmeSoaTable pSoa, uint32_t row, tSmeSoaKey const *pkey)
+{
+	#define SOA_LOAD(col)	_mm_loadu_si128((__m128i const *)&(col)[row])
+	#define SOA_KEY(fld)	_mm_set1_epi32((int)pkey->fld)
+	__m128i diff;
+
+	diff = _mm_xor_si128(SOA_LOAD(pSoa->pState), SOA_KEY(state));
+	diff = _mm_or_si128(diff, _mm_and_si128(_mm_xor_si128(SOA_LOAD(pSoa->pReason1), SOA_KEY(reason1)), SOA_LOAD(pSoa->pMask1)));
+	diff = _mm_or_si128(diff, _mm_and_si128(_mm_xor_si128(SOA_LOAD(pSoa->pReason2), SOA_KEY(reason2)), SOA_LOAD(pSoa->pMask2)));
+	diff = _mm_or_si128(diff, _mm_and_si128(_mm_xor_si128(SOA_LOAD(pSoa->pReason3), SOA_KEY(reason3)), SOA_LOAD(pSoa->pMask3)));
+	return (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(diff, _mm_setzero_si128())));
+	#undef SOA_LOAD
+	#undef SOA_KEY
+}
+#else
+static uint32_t
+SoaMatchBlock(ptSmeSoaTable pSoa, uint32_t row, tSmeSoaKey const *pkey)
+{
+	return SoaMatchRow(pSoa, row, pkey) ? 1u : 0u;
+}
+#endif
+
+/** Is a row whose fields match in a structure-of-arrays table eligible?
+ *	Only the state's low 32 bits are in the columns, so the row is first confirmed against its
+ *	source row; then its guard, if any, is called.
+ */
+static bool
+SoaRowEligible(ptSmeSoaTable pSoa, uint32_t row, pfStateHandler currentstate, tEvQ_Event ev, uint32_t extra)
+{
+	ptTransitionTable pRow = &pSoa->pTbl[row];
+	return (pRow->pfCurrent == currentstate) && (!pRow->pfGuard || pRow->pfGuard(ev, extra));
+}
+
+/** Of the rows of a block whose fields match, take the highest that is eligible.
+ *	@returns The row's lane, or SOA_LANES if there is none.
+ */
+static uint32_t
+SoaTakeHits(ptSmeSoaTable pSoa, uint32_t row, uint32_t hits, pfStateHandler currentstate, tEvQ_Event ev, uint32_t extra)
+{
+	uint32_t lane = SOA_LANES;
+
+	while(hits && lane--)
+	{
+		if(hits & (1u << lane))
+		{
+			hits &= ~(1u << lane);
+			if(SoaRowEligible(pSoa, row + lane, currentstate, ev, extra))	{ return lane; }
+		}
+	}
+	return SOA_LANES;
+}
+
+/** Search of a structure-of-arrays table, from the last row to the first, a block at a time.
+ *	Blocks are compared until one has a row whose fields match; only then is a source row read or
+ *	a guard called, so that the compare loop keeps the columns and the key in registers. The rows
+ *	of the table below the last whole block are compared as one block masked to them; only a table
+ *	smaller than a block is compared one row at a time.
  *
- *	@returns The next state. If NULL, there is no next state and the caller should take appropriate action.
+ *	@returns The selected row, or szTbl if there is none.
  */
-pfStateHandler
-Cwsw_Sme__SME(
-	ptTransitionTable pTblTransitions, uint32_t sztbl,	// individual component's transition table
-	pfStateHandler CurrentState,
-	tEvQ_Event ev, uint32_t extra)
+static uint32_t
+FindRowSoa(ptSmeSoaTable pSoa, pfStateHandler currentstate, tEvQ_Event ev, uint32_t extra)
 {
-	pfStateHandler nextstate = CurrentState;
-	tStateReturnCodes rc = kStateUninit;
+	uint32_t row = pSoa->szTbl;
+	uint32_t hits;
+	uint32_t lane;
+	tSmeSoaKey key;
 
-	if(CurrentState) 	{ rc = CurrentState(&ev, &extra); }
+	key.state	= (uint32_t)(uintptr_t)currentstate;
+	key.reason1	= (uint32_t)ev.evId;
+	key.reason2	= (uint32_t)ev.evData;
+	key.reason3	= extra;
 
-	if(rc > kStateExit)
+	if(pSoa->szTbl < SOA_LANES)
 	{
-		nextstate = Cwsw_Sme_FindNextState(pTblTransitions, sztbl, CurrentState, ev, extra);
+		while(row--)
+		{
+			if(SoaMatchRow(pSoa, row, &key) && SoaRowEligible(pSoa, row, currentstate, ev, extra))	{ return row; }
+		}
+		return pSoa->szTbl;
 	}
-	return nextstate;
+
+	while(row >= SOA_LANES)
+	{
+		do
+		{
+			row -= SOA_LANES;
+			hits = SoaMatchBlock(pSoa, row, &key);
+		} while(!hits && (row >= SOA_LANES));
+		lane = SoaTakeHits(pSoa, row, hits, currentstate, ev, extra);
+		if(lane < SOA_LANES)	{ return row + lane; }
+	}
+	if(row)
+	{
+		lane = SoaTakeHits(pSoa, 0, SoaMatchBlock(pSoa, 0, &key) & ((1u << row) - 1), currentstate, ev, extra);
+		if(lane < SOA_LANES)	{ return lane; }
+	}
+	return pSoa->szTbl;
+}
+
+/** Ordering of the keys in a compiled table.
+ *	Sorts by state, then keyed rows before unkeyed rows, then reason1, then reason3, then by
+ *	descending row number.
+ */
+static int
+KeyCompare(void const *a, void const *b)
+{
+	tSmeIndexKey const *pa = (tSmeIndexKey const *)a;
+	tSmeIndexKey const *pb = (tSmeIndexKey const *)b;
+
+	if(pa->state   != pb->state)	{ return (pa->state   < pb->state)   ? -1 : 1; }
+	if(pa->unkeyed != pb->unkeyed)	{ return (pa->unkeyed < pb->unkeyed) ? -1 : 1; }
+	if(pa->reason1 != pb->reason1)	{ return (pa->reason1 < pb->reason1) ? -1 : 1; }
+	if(pa->reason3 != pb->reason3)	{ return (pa->reason3 < pb->reason3) ? -1 : 1; }
+	if(pa->row     != pb->row)		{ return (pa->row     > pb->row)     ? -1 : 1; }
+	return 0;
+}
+
+/** Binary search of a compiled table for the first key not less than the one given.
+ *	The row number does not take part in the comparison; within a run of equal keys, the rows are
+ *	descending.
+ */
+static uint32_t
+LowerBound(ptSmeTransitionIndex pIndex, tSmeIndexKey const *pkey)
+{
+	uint32_t lo = 0;
+	uint32_t hi = pIndex->nKeys;
+
+	while(lo < hi)
+	{
+		uint32_t mid = lo + (hi - lo) / 2;
+		ptSmeIndexKey pk = &pIndex->pKeys[mid];
+		int lt;
+
+		if(pk->state != pkey->state)				{ lt = (pk->state   < pkey->state); }
+		else if(pk->unkeyed != pkey->unkeyed)		{ lt = (pk->unkeyed < pkey->unkeyed); }
+		else if(pk->reason1 != pkey->reason1)		{ lt = (pk->reason1 < pkey->reason1); }
+		else										{ lt = (pk->reason3 < pkey->reason3); }
+
+		if(lt)	{ lo = mid + 1; }
+		else	{ hi = mid; }
+	}
+	return lo;
+}
+
+/** Search of a compiled table.
+ *	Two runs of keys hold the candidates: the keyed rows that match (state, reason1, reason3)
+ *	exactly, and the state's unkeyed rows. Both are in descending row order; they are merged, and
+ *	the first candidate that is eligible wins, as it would in the linear search.
+ *
+ *	@returns The selected row, or pIndex->szTbl if there is none.
+ */
+static uint32_t
+FindRowIndexed(
+	ptSmeTransitionIndex	pIndex,
+	pfStateHandler			currentstate,
+	tEvQ_Event				ev,
+	uint32_t				extra)
+{
+	tSmeIndexKey keyed   = { 0, 0, 0, 0, 0 };
+	tSmeIndexKey unkeyed = { 0, 0, 0, 0, 0 };
+	uint32_t k, u;
+	bool kvalid, uvalid;
+	uint32_t row;
+
+	keyed.state   = (uintptr_t)currentstate;
+	keyed.reason1 = (uint32_t)ev.evId;
+	keyed.reason3 = extra;
+	unkeyed.state   = (uintptr_t)currentstate;
+	unkeyed.unkeyed = 1;
+
+	k = LowerBound(pIndex, &keyed);
+	u = pIndex->nUnkeyed ? LowerBound(pIndex, &unkeyed) : pIndex->nKeys;
+	for(;;)
+	{
+		kvalid = (k < pIndex->nKeys) &&
+				 (pIndex->pKeys[k].state   == keyed.state) &&
+				 !pIndex->pKeys[k].unkeyed &&
+				 (pIndex->pKeys[k].reason1 == keyed.reason1) &&
+				 (pIndex->pKeys[k].reason3 == keyed.reason3);
+		uvalid = (u < pIndex->nKeys) &&
+				 (pIndex->pKeys[u].state   == unkeyed.state) &&
+				 pIndex->pKeys[u].unkeyed;
+		if(!kvalid && !uvalid)	{ break; }
+
+		if(kvalid && (!uvalid || (pIndex->pKeys[k].row > pIndex->pKeys[u].row)))
+		{
+			row = pIndex->pKeys[k++].row;
+		}
+		else
+		{
+			row = pIndex->pKeys[u++].row;
+		}
+
+		// the key only covers reason1 and reason3; reason2 and the guard are checked here.
+		if(RowMatches(&pIndex->pTbl[row], ev, extra))	{ return row; }
+	}
+	return pIndex->szTbl;
+}
+
+/** Find a state's entry in a hierarchy declaration.
+ *	@returns The entry, or NULL if the state isn't listed (i.e., it's a top-level simple state).
+ */
+static tSmeHsmState const *
+HsmFind(tSmeHsmState const *pStates, uint32_t nStates, pfStateHandler state)
+{
+	uint32_t idx;
+
+	for(idx = 0; idx < nStates; ++idx)
+	{
+		if(pStates[idx].state == state)	{ return &pStates[idx]; }
+	}
+	return NULL;
+}
+
+static pfStateHandler
+HsmParent(tSmeHsmState const *pStates, uint32_t nStates, pfStateHandler state)
+{
+	tSmeHsmState const *pEntry = HsmFind(pStates, nStates, state);
+	return pEntry ? pEntry->parent : NULL;
+}
+
+/** Is a state composite, i.e., the parent of some other state? */
+static bool
+HsmIsComposite(tSmeHsmState const *pStates, uint32_t nStates, pfStateHandler state)
+{
+	uint32_t idx;
+
+	for(idx = 0; idx < nStates; ++idx)
+	{
+		if(state && (pStates[idx].parent == state))	{ return true; }
+	}
+	return false;
+}
+
+/** Does `outer` strictly enclose `state`? */
+static bool
+HsmEncloses(tSmeHsmState const *pStates, uint32_t nStates, pfStateHandler outer, pfStateHandler state)
+{
+	uint32_t depth = nStates;	// a hierarchy can't be deeper than it is wide; this also stops on a loop
+
+	state = HsmParent(pStates, nStates, state);
+	while(state && depth--)
+	{
+		if(state == outer)	{ return true; }
+		state = HsmParent(pStates, nStates, state);
+	}
+	return false;
+}
+
+/** Follow the initial states of a composite state down to a simple state.
+ *	@returns The simple state, or NULL if the composite has no initial state.
+ */
+static pfStateHandler
+HsmResolve(tSmeHsmState const *pStates, uint32_t nStates, pfStateHandler state)
+{
+	uint32_t depth = nStates;
+	tSmeHsmState const *pEntry;
+
+	while(state && HsmIsComposite(pStates, nStates, state))
+	{
+		if(!depth--)	{ return NULL; }
+		pEntry = HsmFind(pStates, nStates, state);
+		state = pEntry ? pEntry->initial : NULL;
+	}
+	return state;
+}
+
+/** Walk the composite actions of one transition.
+ *	The transition is taken by simple state `leaf`, through a row written for `source` (`leaf`
+ *	itself, or a state enclosing it), to `target` (as written in the row) and `dest` (the simple
+ *	state `target` resolves to). The least common ancestor is the innermost state that encloses both
+ *	`source` and `target`; every composite between it and `leaf` is exited, and every composite
+ *	between it and `dest` is entered.
+ *
+ *	If pActions is not NULL, the actions are written there; in any case, they are counted.
+ */
+static void
+HsmPath(
+	tSmeHsmState const *pStates, uint32_t nStates,
+	pfStateHandler leaf, pfStateHandler source, pfStateHandler target, pfStateHandler dest,
+	ptEvQ_EvHandlerFunc *pActions, uint16_t *pnExit, uint16_t *pnEntry)
+{
+	pfStateHandler lca = HsmParent(pStates, nStates, source);
+	pfStateHandler state;
+	tSmeHsmState const *pEntry;
+	uint16_t nExit = 0;
+	uint16_t nEntry = 0;
+	uint16_t idx;
+
+	while(lca && !HsmEncloses(pStates, nStates, lca, target))
+	{
+		lca = HsmParent(pStates, nStates, lca);
+	}
+
+	// exits, innermost first.
+	for(state = HsmParent(pStates, nStates, leaf); state && (state != lca); state = HsmParent(pStates, nStates, state))
+	{
+		pEntry = HsmFind(pStates, nStates, state);
+		if(pEntry && pEntry->pfExit)
+		{
+			if(pActions)	{ pActions[nExit] = pEntry->pfExit; }
+			++nExit;
+		}
+	}
+
+	// entries, outermost first: count them walking up from the destination, then fill backward.
+	for(state = HsmParent(pStates, nStates, dest); state && (state != lca); state = HsmParent(pStates, nStates, state))
+	{
+		pEntry = HsmFind(pStates, nStates, state);
+		if(pEntry && pEntry->pfEntry)	{ ++nEntry; }
+	}
+	if(pActions)
+	{
+		idx = nEntry;
+		for(state = HsmParent(pStates, nStates, dest); state && (state != lca); state = HsmParent(pStates, nStates, state))
+		{
+			pEntry = HsmFind(pStates, nStates, state);
+			if(pEntry && pEntry->pfEntry)	{ pActions[nExit + --idx] = pEntry->pfEntry; }
+		}
+	}
+
+	*pnExit  = nExit;
+	*pnEntry = nEntry;
+}
+
+/** Is a state a simple (leaf) state that the flattened table needs rows for?
+ *	Those are the listed states with no children, plus the states named as current in the table but
+ *	not listed at all; the latter are counted once, at their first row.
+ */
+static bool
+HsmIsLeaf(
+	tSmeHsmState const *pStates, uint32_t nStates,
+	ptTransitionTable pTbl, uint32_t idx, bool fromtable)
+{
+	uint32_t prev;
+	pfStateHandler state;
+
+	if(!fromtable)
+	{
+		return !HsmIsComposite(pStates, nStates, pStates[idx].state);
+	}
+
+	state = pTbl[idx].pfCurrent;
+	if(HsmFind(pStates, nStates, state))	{ return false; }
+	for(prev = 0; prev < idx; ++prev)
+	{
+		if(pTbl[prev].pfCurrent == state)	{ return false; }
+	}
+	return true;
+}
+
+/** Flatten the rows of one simple state: the rows of its outermost enclosing state first, its own
+ *	rows last.
+ *	If pHsm->pFlat is NULL, the rows and actions are only counted.
+ *
+ *	@returns false if a row's target can't be resolved to a simple state, or the storage is full.
+ */
+static bool
+HsmFlattenLeaf(
+	ptSmeHsm pHsm, ptTransitionTable pTbl, uint32_t szTbl, pfStateHandler leaf,
+	uint32_t szFlat, uint32_t szActions)
+{
+	tSmeHsmState const *pStates = pHsm->pStates;
+	uint32_t nStates = pHsm->nStates;
+	pfStateHandler source;
+	pfStateHandler dest;
+	uint32_t depth;
+	uint32_t level;
+	uint32_t tblidx;
+	uint16_t nExit, nEntry;
+
+	// depth of the leaf, so the enclosing states can be visited outermost first.
+	depth = 0;
+	for(source = HsmParent(pStates, nStates, leaf); source && (depth < nStates); source = HsmParent(pStates, nStates, source))
+	{
+		++depth;
+	}
+
+	for(level = depth + 1; level--; )
+	{
+		// the state `level` steps out from the leaf.
+		source = leaf;
+		for(tblidx = 0; tblidx < level; ++tblidx)	{ source = HsmParent(pStates, nStates, source); }
+
+		for(tblidx = 0; tblidx < szTbl; ++tblidx)
+		{
+			if(pTbl[tblidx].pfCurrent != source)	{ continue; }
+
+			dest = HsmResolve(pStates, nStates, pTbl[tblidx].pfNext);
+			if(pTbl[tblidx].pfNext && !dest)		{ return false; }
+
+			if(pHsm->pFlat)
+			{
+				if(pHsm->szFlat >= szFlat)			{ return false; }
+				HsmPath(pStates, nStates, leaf, source, pTbl[tblidx].pfNext, dest, NULL, &nExit, &nEntry);
+				if((pHsm->nActions + nExit + nEntry) > szActions)	{ return false; }
+				HsmPath(pStates, nStates, leaf, source, pTbl[tblidx].pfNext, dest,
+						&pHsm->pActions[pHsm->nActions], &nExit, &nEntry);
+
+				pHsm->pFlat[pHsm->szFlat] = pTbl[tblidx];
+				pHsm->pFlat[pHsm->szFlat].pfCurrent = leaf;
+				pHsm->pFlat[pHsm->szFlat].pfNext = dest;
+				pHsm->pPaths[pHsm->szFlat].first  = pHsm->nActions;
+				pHsm->pPaths[pHsm->szFlat].nExit  = nExit;
+				pHsm->pPaths[pHsm->szFlat].nEntry = nEntry;
+			}
+			else
+			{
+				HsmPath(pStates, nStates, leaf, source, pTbl[tblidx].pfNext, dest, NULL, &nExit, &nEntry);
+			}
+			++pHsm->szFlat;
+			pHsm->nActions += (uint32_t)nExit + nEntry;
+		}
+	}
+	return true;
+}
+
+/** Flatten a hierarchy, or, if pHsm->pFlat is NULL, only count the storage it needs. */
+static bool
+HsmFlatten(ptSmeHsm pHsm, ptTransitionTable pTbl, uint32_t szTbl, uint32_t szFlat, uint32_t szActions)
+{
+	uint32_t idx;
+
+	pHsm->szFlat   = 0;
+	pHsm->nActions = 0;
+	for(idx = 0; idx < pHsm->nStates; ++idx)
+	{
+		if(!HsmIsLeaf(pHsm->pStates, pHsm->nStates, pTbl, idx, false))	{ continue; }
+		if(!HsmFlattenLeaf(pHsm, pTbl, szTbl, pHsm->pStates[idx].state, szFlat, szActions))
+		{
+			return false;
+		}
+	}
+	for(idx = 0; idx < szTbl; ++idx)
+	{
+		if(!HsmIsLeaf(pHsm->pStates, pHsm->nStates, pTbl, idx, true))	{ continue; }
+		if(!HsmFlattenLeaf(pHsm, pTbl, szTbl, pTbl[idx].pfCurrent, szFlat, szActions))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/** Find the interest set for one state.
+ *	@returns The state's entry, or NULL if the state has none.
+ */
+static ptSmeInterestEntry
+FindInterest(ptSmeInterest pInterest, uintptr_t state)
+{
+	uint32_t lo = 0;
+	uint32_t hi = pInterest->nEntries;
+
+	while(lo < hi)
+	{
+		uint32_t mid = lo + (hi - lo) / 2;
+		if(pInterest->pEntries[mid].state < state)			{ lo = mid + 1; }
+		else if(pInterest->pEntries[mid].state > state)		{ hi = mid; }
+		else												{ return &pInterest->pEntries[mid]; }
+	}
+	return NULL;
+}
+
+/** Find or create the interest set for one state, keeping the sets sorted by state.
+ *	@returns The state's entry, or NULL if the storage is exhausted.
+ */
+static ptSmeInterestEntry
+AddInterest(ptSmeInterest pInterest, uint32_t szEntries, uintptr_t state)
+{
+	ptSmeInterestEntry pEntry = FindInterest(pInterest, state);
+	uint32_t idx;
+
+	if(pEntry)									{ return pEntry; }
+	if(pInterest->nEntries >= szEntries)		{ return NULL; }
+
+	idx = pInterest->nEntries++;
+	while(idx && (pInterest->pEntries[idx - 1].state > state))
+	{
+		pInterest->pEntries[idx] = pInterest->pEntries[idx - 1];
+		--idx;
+	}
+	memset(&pInterest->pEntries[idx], 0, sizeof(pInterest->pEntries[idx]));
+	pInterest->pEntries[idx].state = state;
+	return &pInterest->pEntries[idx];
+}
+
+/** Add one event ID to an interest set. IDs beyond the set's range are always dispatched anyway. */
+static void
+SetInterest(ptSmeInterestEntry pEntry, uint32_t evId)
+{
+	if(evId < CWSW_SME_INTEREST_EVENTS)
+	{
+		pEntry->events[evId / 32] |= (uint32_t)1 << (evId % 32);
+	}
+}
+
+/** Does a state have a reaction to an event?
+ *	States without an interest set, and events outside the range of the sets, are always of
+ *	interest.
+ */
+static bool
+IsInterested(ptSmeInterest pInterest, pfStateHandler state, tEvQ_EventID evId)
+{
+	ptSmeInterestEntry pEntry;
+	uint32_t id = (uint32_t)evId;
+
+	if(id >= CWSW_SME_INTEREST_EVENTS)					{ return true; }
+	pEntry = FindInterest(pInterest, (uintptr_t)state);
+	if(!pEntry)											{ return true; }
+	return (pEntry->events[id / 32] >> (id % 32)) & 1u;
+}
+
+/** Call a state handler, with the signature the machine's states use. */
+static tStateReturnCodes
+CallState(tSmeMachine const *pm, pfStateHandler state, ptEvQ_Event pev, uint32_t *pextra)
+{
+	tSmeInstCtx ctx;
+
+	if(!pm->pPool)	{ return state(pev, pextra); }
+
+	ctx.pPool = pm->pPool;
+	ctx.inst  = pm->inst;
+	return ((pfSmeInstStateHandler)(void (*)(void))state)(&ctx, pev, pextra);
+}
+
+/** Find the next state, using the machine's hierarchy or compiled table when it has one. */
+static pfStateHandler
+FindNext(tSmeMachine const *pm, pfStateHandler currentstate, tEvQ_Event ev, uint32_t extra)
+{
+	if(pm->pHsm)
+	{
+		return Cwsw_Sme_FindNextStateHsm(pm->pHsm, currentstate, ev, extra);
+	}
+	if(pm->pIndex)
+	{
+		return Cwsw_Sme_FindNextStateIndexed(pm->pIndex, currentstate, ev, extra);
+	}
+	return Cwsw_Sme_FindNextState(pm->pTbl, pm->szTbl, currentstate, ev, extra);
+}
+
+/** One SME step, in the original stepwise mode.
+ *	The current state is called once; if it has finished its exit action, the next state is found.
+ *	The next state's entry action runs on the following step.
+ */
+static pfStateHandler
+Step(tSmeMachine const *pm, pfStateHandler CurrentState, tEvQ_Event ev, uint32_t extra)
+{
+	pfStateHandler nextstate = CurrentState;
+	tStateReturnCodes rc = kStateUninit;
+	STATS_STEP_BEGIN(pm);
+
+	if(CurrentState) 	{ rc = CallState(pm, CurrentState, &ev, &extra); }
+
+	if(rc > kStateExit)
+	{
+		nextstate = FindNext(pm, CurrentState, ev, extra);
+	}
+	STATS_STEP_END();
+	return nextstate;
+}
+
+/** One SME step, in run-to-completion mode.
+ *	Within this one call, a state that announces its exit (kStateExit) is called again to execute
+ *	its exit action; the transition is selected and taken; and the next state is called to execute
+ *	its entry action. If that state announces its exit immediately, the chain continues, up to
+ *	`maxtransitions` transitions. The bound stops further transitions, never the entry action of the
+ *	state just selected: once it is reached, a state that announces its exit is left to execute its
+ *	exit action on the next step, as in stepwise mode.
+ *
+ *	Every state in the chain is presented with the event that started the step.
+ */
+static pfStateHandler
+RunToCompletion(
+	tSmeMachine const *pm, pfStateHandler CurrentState,
+	tEvQ_Event ev, uint32_t extra,
+	uint32_t maxtransitions, uint32_t *ptransitions)
+{
+	uint32_t transitions = 0;
+	tStateReturnCodes rc;
+	tEvQ_Event reasons;
+	uint32_t reason3;
+	STATS_STEP_BEGIN(pm);
+
+	while(CurrentState)
+	{
+		reasons = ev;
+		reason3 = extra;
+		rc = CallState(pm, CurrentState, &reasons, &reason3);
+		if((rc == kStateExit) && (transitions < maxtransitions))
+		{
+			// execute the exit action now, rather than on the next step.
+			rc = CallState(pm, CurrentState, &reasons, &reason3);
+		}
+		if(rc <= kStateExit)						{ break; }
+
+		/* a state that skipped straight past kStateExit has already done its exit action, and is
+		 * left even at the bound; the count still keeps a chain of such states from running forever.
+		 */
+		CurrentState = FindNext(pm, CurrentState, reasons, reason3);
+		if(++transitions > maxtransitions)		{ break; }
+	}
+
+	if(ptransitions)	{ *ptransitions = transitions; }
+	STATS_STEP_END();
+	return CurrentState;
+}
+
+/** One SME step for one pool instance, in the pool's mode. */
+static pfStateHandler
+StepInst(ptSmePool pPool, tSmeInstance inst, tEvQ_Event ev, uint32_t extra)
+{
+	tSmeMachine m;
+
+	/* a state that is between its entry and exit actions has nothing to do for an event it has
+	 * no reaction to. a state in any other phase must run regardless, to complete its entry or exit.
+	 */
+	if(pPool->pInterest && (pPool->pPhase[inst] == kStateOperational))
+	{
+		if(!IsInterested(pPool->pInterest, pPool->pState[inst], ev.evId))
+		{
+			INTEREST_COUNT(pPool->pInterest->skipped);
+			return pPool->pState[inst];
+		}
+		INTEREST_COUNT(pPool->pInterest->dispatched);
+	}
+
+	m.pTbl   = pPool->pTbl;
+	m.szTbl  = pPool->szTbl;
+	m.pIndex = pPool->pIndex;
+	m.pHsm   = pPool->pHsm;
+	m.pPool  = pPool;
+	m.inst   = inst;
+	if(pPool->maxchain)
+	{
+		pPool->pState[inst] = RunToCompletion(&m, pPool->pState[inst], ev, extra, pPool->maxchain, NULL);
+	}
+	else
+	{
+		pPool->pState[inst] = Step(&m, pPool->pState[inst], ev, extra);
+	}
+	return pPool->pState[inst];
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/** Search for the next state.
+ *	If found, execute transition function, if any specified.
+ */
+pfStateHandler
+Cwsw_Sme_FindNextState(
+	ptTransitionTable	pTblTransition,		// 1st row of transition table
+	uint32_t			szTblTransition,	// size in rows of transition table
+	pfStateHandler		currentstate,
+	tEvQ_Event			ev, 				// 1st two exit reasons
+	uint32_t 			extra)				// 3rd exit reason
+{
+	uint32_t tblidx = FindRow(pTblTransition, szTblTransition, currentstate, ev, extra);
+	if(tblidx < szTblTransition)
+	{
+		return TakeRow(&pTblTransition[tblidx], tblidx, ev, extra);
+	}
+	STATS_MISS();
+	return currentstate;
+}
+
+
+/** Compile a transition table for indexed lookup.
+ *	This is a one-time operation, normally done at init, that replaces the linear search of
+ *	Cwsw_Sme_FindNextState() with a binary search, O(log n) in the size of the table. The selection
+ *	rules are unchanged: when more than one row is eligible, the last one wins.
+ *
+ *	Rows that compare both reason1 and reason3 are found directly. Rows that leave either out of
+ *	the comparison can't be keyed on it; they are kept per state and tried alongside, so a table with
+ *	many of these degrades toward the linear search for the states that have them.
+ *
+ *	@param[out]	pIndex			Index to build.
+ *	@param[in]	pTblTransition	Transition table to compile. Must not be modified afterward.
+ *	@param[in]	szTblTransition	Size in rows of the transition table.
+ *	@param[in]	pKeys			Caller-provided storage for the index keys.
+ *	@param[in]	szKeys			Size in keys of pKeys. Must be at least szTblTransition.
+ *
+ *	@returns true if the index was built, false if the arguments are invalid.
+ */
+bool
+Cwsw_Sme_CompileTable(
+	ptSmeTransitionIndex	pIndex,
+	ptTransitionTable		pTblTransition,
+	uint32_t				szTblTransition,
+	ptSmeIndexKey			pKeys,
+	uint32_t				szKeys)
+{
+	uint32_t tblidx;
+
+	if(!pIndex)										{ return false; }
+	if(!pTblTransition || !pKeys)					{ return false; }
+	if(szKeys < szTblTransition)					{ return false; }
+
+	pIndex->nUnkeyed = 0;
+	for(tblidx = 0; tblidx < szTblTransition; ++tblidx)
+	{
+		uint32_t match = RowMatchMask(&pTblTransition[tblidx]);
+
+		pKeys[tblidx].state   = (uintptr_t)pTblTransition[tblidx].pfCurrent;
+		pKeys[tblidx].row     = tblidx;
+		if((match & (kSmeMatch_Reason1 | kSmeMatch_Reason3)) == (kSmeMatch_Reason1 | kSmeMatch_Reason3))
+		{
+			pKeys[tblidx].unkeyed = 0;
+			pKeys[tblidx].reason1 = pTblTransition[tblidx].reason1;
+			pKeys[tblidx].reason3 = pTblTransition[tblidx].reason3;
+		}
+		else
+		{
+			pKeys[tblidx].unkeyed = 1;
+			pKeys[tblidx].reason1 = 0;
+			pKeys[tblidx].reason3 = 0;
+			++pIndex->nUnkeyed;
+		}
+	}
+	qsort(pKeys, szTblTransition, sizeof(*pKeys), KeyCompare);
+
+	pIndex->pTbl  = pTblTransition;
+	pIndex->szTbl = szTblTransition;
+	pIndex->pKeys = pKeys;
+	pIndex->nKeys = szTblTransition;
+	return true;
+}
+
+
+/** Search for the next state in a compiled transition table.
+ *	Behaves exactly as Cwsw_Sme_FindNextState() does on the source table.
+ */
+pfStateHandler
+Cwsw_Sme_FindNextStateIndexed(
+	ptSmeTransitionIndex	pIndex,
+	pfStateHandler			currentstate,
+	tEvQ_Event				ev,
+	uint32_t				extra)
+{
+	uint32_t tblidx = FindRowIndexed(pIndex, currentstate, ev, extra);
+	if(tblidx < pIndex->szTbl)
+	{
+		return TakeRow(&pIndex->pTbl[tblidx], tblidx, ev, extra);
+	}
+	STATS_MISS();
+	return currentstate;
+}
+
+
+/** CWSW State Machine Engine task.
+ *	This is the core SM Engine. It is intended to be called from the SME of a specific state machine.
+ *
+ *	@param[in] pTblTransitions 	The transition table of the calling SM.
+ *	@param[in] sztbl 			Size of the caller's transition table.
+ *	@param[in] CurrentState 	The current state.
+ *	@param[in] ev 				Event parameter passed to the calling SME by the event dispatcher.
+ *	@param[in] extra 			Extra parameter passed to the calling SME by the event dispatcher.
+ *
+ *	@returns The next state. If NULL, there is no next state and the caller should take appropriate action.
+ */
+pfStateHandler
+Cwsw_Sme__SME(
+	ptTransitionTable pTblTransitions, uint32_t sztbl,	// individual component's transition table
+	pfStateHandler CurrentState,
+	tEvQ_Event ev, uint32_t extra)
+{
+	tSmeMachine m = { NULL, 0, NULL, NULL, NULL, 0 };
+
+	m.pTbl  = pTblTransitions;
+	m.szTbl = sztbl;
+	return Step(&m, CurrentState, ev, extra);
+}
+
+
+/** CWSW State Machine Engine task, in run-to-completion mode.
+ *	Where Cwsw_Sme__SME() spreads a transition across several calls (exit action, then transition,
+ *	then the next state's entry action), this completes it within one call: the exit, the
+ *	transition function, and the next state's entry action all run before it returns. A chain of
+ *	states that exit immediately upon entry is followed, up to `maxtransitions` transitions.
+ *
+ *	@param[in]	pTblTransitions	The transition table of the calling SM.
+ *	@param[in]	sztbl			Size of the caller's transition table.
+ *	@param[in]	CurrentState	The current state.
+ *	@param[in]	ev				Event parameter passed to the calling SME by the event dispatcher.
+ *	@param[in]	extra			Extra parameter passed to the calling SME by the event dispatcher.
+ *	@param[in]	maxtransitions	Bound on the transitions taken in this call; 0 selects
+ *								CWSW_SME_RTC_MAXCHAIN.
+ *	@param[out]	ptransitions	If not NULL, receives the number of transitions taken. Reaching
+ *								the bound does not by itself mean the chain was cut short: the
+ *								last state selected has run its entry action either way; only if it
+ *								also announced its exit is that exit left for the next call.
+ *
+ *	@returns The next state. If NULL, there is no next state and the caller should take appropriate action.
+ */
+pfStateHandler
+Cwsw_Sme__SMERunToCompletion(
+	ptTransitionTable pTblTransitions, uint32_t sztbl,
+	pfStateHandler CurrentState,
+	tEvQ_Event ev, uint32_t extra,
+	uint32_t maxtransitions, uint32_t *ptransitions)
+{
+	tSmeMachine m = { NULL, 0, NULL, NULL, NULL, 0 };
+
+	m.pTbl  = pTblTransitions;
+	m.szTbl = sztbl;
+	if(!maxtransitions)	{ maxtransitions = CWSW_SME_RTC_MAXCHAIN; }
+	return RunToCompletion(&m, CurrentState, ev, extra, maxtransitions, ptransitions);
+}
+
+
+
+/** CWSW State Machine Engine task, using a compiled transition table.
+ *	Identical to Cwsw_Sme__SME(), except the next state is found via Cwsw_Sme_FindNextStateIndexed().
+ */
+pfStateHandler
+Cwsw_Sme__SMEIndexed(
+	ptSmeTransitionIndex pIndex,						// individual component's compiled transition table
+	pfStateHandler CurrentState,
+	tEvQ_Event ev, uint32_t extra)
+{
+	tSmeMachine m = { NULL, 0, NULL, NULL, NULL, 0 };
+
+	m.pIndex = pIndex;
+	return Step(&m, CurrentState, ev, extra);
+}
+
+
+/** Build the structure-of-arrays form of a transition table.
+ *	This is a one-time operation, cheap enough to do whenever a table is loaded: one pass over the
+ *	rows, with no sorting. The selection rules are unchanged.
+ *
+ *	@returns true if the table was built, false if the arguments are invalid.
+ */
+bool
+Cwsw_Sme_SoaBuild(
+	ptSmeSoaTable			pSoa,
+	ptTransitionTable		pTblTransition,
+	uint32_t				szTblTransition,
+	uint32_t				*pColumns,
+	uint32_t				szColumns)
+{
+	uint32_t tblidx;
+
+	if(!pSoa || !pTblTransition || !pColumns)						{ return false; }
+	if(szColumns / SME_SOA_COLUMNS < szTblTransition)				{ return false; }
+
+	pSoa->pTbl		= pTblTransition;
+	pSoa->szTbl		= szTblTransition;
+	pSoa->pState	= &pColumns[0 * szTblTransition];
+	pSoa->pReason1	= &pColumns[1 * szTblTransition];
+	pSoa->pReason2	= &pColumns[2 * szTblTransition];
+	pSoa->pReason3	= &pColumns[3 * szTblTransition];
+	pSoa->pMask1	= &pColumns[4 * szTblTransition];
+	pSoa->pMask2	= &pColumns[5 * szTblTransition];
+	pSoa->pMask3	= &pColumns[6 * szTblTransition];
+
+	for(tblidx = 0; tblidx < szTblTransition; ++tblidx)
+	{
+		ptTransitionTable pRow = &pTblTransition[tblidx];
+		uint32_t match = RowMatchMask(pRow);
+
+		pSoa->pState[tblidx]   = (uint32_t)(uintptr_t)pRow->pfCurrent;
+		pSoa->pReason1[tblidx] = pRow->reason1;
+		pSoa->pReason2[tblidx] = pRow->reason2;
+		pSoa->pReason3[tblidx] = pRow->reason3;
+		pSoa->pMask1[tblidx]   = (match & kSmeMatch_Reason1) ? UINT32_MAX : 0;
+		pSoa->pMask2[tblidx]   = (match & kSmeMatch_Reason2) ? UINT32_MAX : 0;
+		pSoa->pMask3[tblidx]   = (match & kSmeMatch_Reason3) ? UINT32_MAX : 0;
+	}
+	return true;
+}
+
+
+/** Search for the next state in a structure-of-arrays table.
+ *	Behaves exactly as Cwsw_Sme_FindNextState() does on the source table.
+ */
+pfStateHandler
+Cwsw_Sme_FindNextStateSoa(
+	ptSmeSoaTable			pSoa,
+	pfStateHandler			currentstate,
+	tEvQ_Event				ev,
+	uint32_t				extra)
+{
+	uint32_t tblidx = FindRowSoa(pSoa, currentstate, ev, extra);
+	if(tblidx < pSoa->szTbl)
+	{
+		return TakeRow(&pSoa->pTbl[tblidx], tblidx, ev, extra);
+	}
+	STATS_MISS();
+	return currentstate;
+}
+
+
+/** CWSW State Machine Engine task, using a structure-of-arrays table.
+ *	Identical to Cwsw_Sme__SME(), except the next state is found via Cwsw_Sme_FindNextStateSoa().
+ */
+pfStateHandler
+Cwsw_Sme__SMESoa(
+	ptSmeSoaTable pSoa,
+	pfStateHandler CurrentState,
+	tEvQ_Event ev, uint32_t extra)
+{
+	tStateReturnCodes rc = kStateUninit;
+	STATS_STEP_BEGIN(NULL);
+
+	if(CurrentState)	{ rc = CurrentState(&ev, &extra); }
+
+	if(rc > kStateExit)
+	{
+		CurrentState = Cwsw_Sme_FindNextStateSoa(pSoa, CurrentState, ev, extra);
+	}
+	STATS_STEP_END();
+	return CurrentState;
+}
+
+
+/** Pack a transition table.
+ *	Builds the packed form of a transition table, normally once at init, or offline to produce a
+ *	`const` table for rodata. The caller provides the state list, in the order of its state
+ *	enumeration, and the lists of transition and guard functions; each function the table uses must
+ *	appear in its list. The rows are grouped by current state, keeping their order within a state,
+ *	so selection is unchanged: when more than one row is eligible, the last one wins.
+ *
+ *	@returns true if the table was packed; false if the arguments are invalid, a function isn't
+ *	in its list, or a compared reason doesn't fit in 16 bits.
+ */
+bool
+Cwsw_Sme_PackTable(
+	ptSmePackedTable			pPacked,
+	ptTransitionTable			pTblTransition,
+	uint32_t					szTblTransition,
+	pfStateHandler const		*pStates,
+	uint32_t					nStates,
+	ptEvQ_EvHandlerFunc const	*pTransitions,
+	uint32_t					nTransitions,
+	pfSmeGuard const			*pGuards,
+	uint32_t					nGuards,
+	tSmePackedRow				*pRows,
+	uint16_t					*pFirst,
+	uint32_t					szRows)
+{
+	uint32_t tblidx;
+	uint32_t idx;
+
+	if(!pPacked || !pTblTransition || !pStates || !pRows || !pFirst)	{ return false; }
+	if(szRows < szTblTransition)										{ return false; }
+	if(szTblTransition > UINT16_MAX)									{ return false; }
+	if(!nStates || (nStates > 256) || (nTransitions > 256) || (nGuards > 256))	{ return false; }
+
+	/* count the rows of each state into pFirst[n + 1], and sum the counts so that pFirst[n] is the
+	 * first row of state n; then place each row at its state's next free position.
+	 */
+	memset(pFirst, 0, (nStates + 1) * sizeof(*pFirst));
+	for(tblidx = 0; tblidx < szTblTransition; ++tblidx)
+	{
+		for(idx = 0; (idx < nStates) && (pStates[idx] != pTblTransition[tblidx].pfCurrent); ++idx)	{ }
+		if(idx == nStates)	{ return false; }
+		++pFirst[idx + 1];
+	}
+	for(idx = 1; idx <= nStates; ++idx)
+	{
+		pFirst[idx] = (uint16_t)(pFirst[idx] + pFirst[idx - 1]);
+	}
+
+	for(tblidx = 0; tblidx < szTblTransition; ++tblidx)
+	{
+		ptTransitionTable pRow = &pTblTransition[tblidx];
+		uint32_t match = RowMatchMask(pRow);
+		tSmePackedRow packed;
+		uint32_t cur;
+		uint32_t next;
+		uint32_t trans = 0;
+		uint32_t guard = 0;
+
+		for(cur = 0; pStates[cur] != pRow->pfCurrent; ++cur)									{ }
+		for(next = 0; (next < nStates) && (pStates[next] != pRow->pfNext); ++next)			{ }
+		if(pRow->pfTransition)
+		{
+			for(trans = 1; (trans < nTransitions) && (pTransitions[trans] != pRow->pfTransition); ++trans)	{ }
+			if(trans >= nTransitions)	{ return false; }
+		}
+		if(pRow->pfGuard)
+		{
+			if(!pGuards)				{ return false; }
+			for(guard = 1; (guard < nGuards) && (pGuards[guard] != pRow->pfGuard); ++guard)	{ }
+			if(guard >= nGuards)		{ return false; }
+		}
+		if(next == nStates)																		{ return false; }
+		if((match & kSmeMatch_Reason1) && (pRow->reason1 > UINT16_MAX))						{ return false; }
+		if((match & kSmeMatch_Reason2) && (pRow->reason2 > UINT16_MAX))						{ return false; }
+		if((match & kSmeMatch_Reason3) && (pRow->reason3 > UINT16_MAX))						{ return false; }
+
+		packed.reason1		= (uint16_t)((match & kSmeMatch_Reason1) ? pRow->reason1 : 0);
+		packed.reason2		= (uint16_t)((match & kSmeMatch_Reason2) ? pRow->reason2 : 0);
+		packed.reason3		= (uint16_t)((match & kSmeMatch_Reason3) ? pRow->reason3 : 0);
+		packed.current		= (uint8_t)cur;
+		packed.next			= (uint8_t)next;
+		packed.transition	= (uint8_t)trans;
+		packed.guard		= (uint8_t)guard;
+		packed.match		= (uint8_t)match;
+		packed.rsvd			= 0;
+		pRows[pFirst[cur]++] = packed;
+	}
+
+	// each pFirst[n] now holds the end of state n; shift them up to make them starts.
+	for(idx = nStates; idx > 0; --idx)
+	{
+		pFirst[idx] = pFirst[idx - 1];
+	}
+	pFirst[0] = 0;
+
+	pPacked->pRows			= pRows;
+	pPacked->nRows			= szTblTransition;
+	pPacked->pFirst			= pFirst;
+	pPacked->pStates		= pStates;
+	pPacked->nStates		= nStates;
+	pPacked->pTransitions	= pTransitions;
+	pPacked->pGuards		= pGuards;
+	return true;
+}
+
+
+/** Search for the next state in a packed transition table.
+ *	Behaves as Cwsw_Sme_FindNextState() does, but on state indices.
+ *
+ *	@returns The index of the next state; `currentstate` if no row is eligible.
+ */
+uint8_t
+Cwsw_Sme_FindNextStatePacked(
+	tSmePackedTable const	*pPacked,
+	uint8_t					currentstate,
+	tEvQ_Event				ev,
+	uint32_t				extra)
+{
+	tSmePackedRow const *pRow;
+	uint32_t rowidx = FindPackedRow(pPacked, currentstate, ev, extra);
+
+	if(rowidx >= pPacked->nRows)	{ STATS_MISS(); return currentstate; }
+
+	pRow = &pPacked->pRows[rowidx];
+	TRACE_RECORD(pPacked->pStates[pRow->current], pPacked->pStates[pRow->next], rowidx, ev, extra);
+	STATS_ROW(pPacked->pStates[pRow->current], pPacked->pStates[pRow->next], rowidx);
+	if(pRow->transition)
+	{
+		pPacked->pTransitions[pRow->transition](ev, extra);
+	}
+	return pRow->next;
+}
+
+
+/** CWSW State Machine Engine task, using a packed transition table.
+ *	Identical to Cwsw_Sme__SME(), except that the machine's state is held as an index into the
+ *	packed table's state list, and the next state is found via Cwsw_Sme_FindNextStatePacked().
+ *
+ *	@returns The index of the next state. If 0, there is no next state and the caller should take
+ *	appropriate action.
+ */
+uint8_t
+Cwsw_Sme__SMEPacked(
+	tSmePackedTable const *pPacked,
+	uint8_t CurrentState,
+	tEvQ_Event ev, uint32_t extra)
+{
+	tStateReturnCodes rc = kStateUninit;
+	pfStateHandler state = (CurrentState < pPacked->nStates) ? pPacked->pStates[CurrentState] : NULL;
+	STATS_STEP_BEGIN(NULL);
+
+	if(state)	{ rc = state(&ev, &extra); }
+
+	if(rc > kStateExit)
+	{
+		CurrentState = Cwsw_Sme_FindNextStatePacked(pPacked, CurrentState, ev, extra);
+	}
+	STATS_STEP_END();
+	return CurrentState;
+}
+
+
+/** CWSW State Machine Engine task, for a batch of events.
+ *	Runs each event through the machine in order, exactly as that many calls to Cwsw_Sme__SME()
+ *	would. What doesn't change from one event to the next is done once for the batch: the machine is
+ *	known to be a plain one, so each step goes straight to the state and the linear search with no
+ *	dispatch on instance, hierarchy or index; and with CWSW_SME_STATS, the machine's entry time is
+ *	selected once and each step is timed from the end of the one before, one clock read per event
+ *	rather than two.
+ *
+ *	@param[in]	pTblTransitions	The transition table of the calling SM.
+ *	@param[in]	sztbl			Size of the caller's transition table.
+ *	@param[in]	CurrentState	The current state.
+ *	@param[in]	pEvents			Events to process, in order.
+ *	@param[in]	pExtras			Extra parameter for each event; if NULL, 0 is used for every event.
+ *	@param[in]	nEvents			Number of events.
+ *	@param[out]	pNextStates		If not NULL, receives the state after each event.
+ *
+ *	@returns The state after the last event.
+ */
+pfStateHandler
+Cwsw_Sme__SMEBatch(
+	ptTransitionTable pTblTransitions, uint32_t sztbl,
+	pfStateHandler CurrentState,
+	tEvQ_Event const *pEvents, uint32_t const *pExtras,
+	uint32_t nEvents,
+	pfStateHandler *pNextStates)
+{
+	tStateReturnCodes rc;
+	tEvQ_Event ev;
+	uint32_t extra;
+	uint32_t evidx;
+	STATS_BATCH_BEGIN(NULL);
+
+	if(!pEvents)	{ return CurrentState; }
+
+	for(evidx = 0; evidx < nEvents; ++evidx)
+	{
+		ev    = pEvents[evidx];
+		extra = pExtras ? pExtras[evidx] : 0;
+		rc    = kStateUninit;
+
+		// Step(), for a plain machine: no instance context, hierarchy or index to dispatch on.
+		if(CurrentState)	{ rc = CurrentState(&ev, &extra); }
+		if(rc > kStateExit)
+		{
+			CurrentState = Cwsw_Sme_FindNextState(pTblTransitions, sztbl, CurrentState, ev, extra);
+		}
+		STATS_BATCH_STEP();
+		if(pNextStates)		{ pNextStates[evidx] = CurrentState; }
+	}
+	return CurrentState;
+}
+
+
+/** Size the storage for a flattened hierarchy.
+ *	@returns true if the hierarchy can be flattened; *pszFlat and *pnActions then hold the sizes to
+ *	pass to Cwsw_Sme_Hsm_Init().
+ */
+bool
+Cwsw_Sme_Hsm_Size(
+	tSmeHsmState const		*pStates,
+	uint32_t				nStates,
+	ptTransitionTable		pTblTransition,
+	uint32_t				szTblTransition,
+	uint32_t				*pszFlat,
+	uint32_t				*pnActions)
+{
+	tSmeHsm hsm;
+
+	if(!pszFlat || !pnActions)							{ return false; }
+	if(!pStates && nStates)								{ return false; }
+	if(!pTblTransition && szTblTransition)				{ return false; }
+
+	memset(&hsm, 0, sizeof(hsm));
+	hsm.pStates = pStates;
+	hsm.nStates = nStates;
+	if(!HsmFlatten(&hsm, pTblTransition, szTblTransition, 0, 0))	{ return false; }
+
+	*pszFlat   = hsm.szFlat;
+	*pnActions = hsm.nActions;
+	return true;
+}
+
+/** Flatten a hierarchical state machine.
+ *	This is a one-time operation, normally done at init. Use Cwsw_Sme_Hsm_Size() to size the
+ *	storage. The flattened table can in turn be compiled with Cwsw_Sme_CompileTable(), and the
+ *	result placed in pHsm->pIndex.
+ *
+ *	@param[out]	pHsm			Hierarchy to build.
+ *	@param[in]	pStates			Hierarchy declaration; must outlive pHsm.
+ *	@param[in]	nStates			Entries in the hierarchy declaration.
+ *	@param[in]	pTblTransition	Transition table, whose rows may name composite states.
+ *	@param[in]	szTblTransition	Size in rows of the transition table.
+ *	@param[in]	pFlat			Storage for the flattened table.
+ *	@param[in]	pPaths			Storage for the action path of each flattened row.
+ *	@param[in]	szFlat			Size in rows of pFlat and pPaths.
+ *	@param[in]	pActions		Storage for the action list.
+ *	@param[in]	szActions		Size in entries of pActions.
+ *
+ *	@returns true if the hierarchy was flattened; false if the arguments are invalid, a row targets
+ *	a composite state with no initial state, or the storage is too small.
+ */
+bool
+Cwsw_Sme_Hsm_Init(
+	ptSmeHsm				pHsm,
+	tSmeHsmState const		*pStates,
+	uint32_t				nStates,
+	ptTransitionTable		pTblTransition,
+	uint32_t				szTblTransition,
+	ptTransitionTable		pFlat,
+	ptSmeHsmPath			pPaths,
+	uint32_t				szFlat,
+	ptEvQ_EvHandlerFunc		*pActions,
+	uint32_t				szActions)
+{
+	if(!pHsm || !pFlat || !pPaths)						{ return false; }
+	if(!pStates && nStates)								{ return false; }
+	if(!pTblTransition && szTblTransition)				{ return false; }
+	if(!pActions && szActions)							{ return false; }
+
+	memset(pHsm, 0, sizeof(*pHsm));
+	pHsm->pStates  = pStates;
+	pHsm->nStates  = nStates;
+	pHsm->pFlat    = pFlat;
+	pHsm->pPaths   = pPaths;
+	pHsm->pActions = pActions;
+	return HsmFlatten(pHsm, pTblTransition, szTblTransition, szFlat, szActions);
+}
+
+/** Resolve a state to the simple state that is entered when it is the target of a transition.
+ *	Use this to pick the initial current state of a hierarchical machine.
+ *
+ *	@returns The simple state; `state` itself if it is not composite.
+ */
+pfStateHandler
+Cwsw_Sme_Hsm_Resolve(ptSmeHsm pHsm, pfStateHandler state)
+{
+	if(!pHsm)	{ return state; }
+	return HsmResolve(pHsm->pStates, pHsm->nStates, state);
+}
+
+/** Search for the next state of a hierarchical machine.
+ *	One lookup, in the flattened table; then the composite exit actions, the transition function,
+ *	and the composite entry actions of the selected row, in that order. The exit action of the
+ *	current state and the entry action of the next state are theirs to run, as for any machine.
+ */
+pfStateHandler
+Cwsw_Sme_FindNextStateHsm(
+	ptSmeHsm				pHsm,
+	pfStateHandler			currentstate,
+	tEvQ_Event				ev,
+	uint32_t				extra)
+{
+	uint32_t tblidx;
+	uint32_t action;
+	ptSmeHsmPath pPath;
+
+	if(pHsm->pIndex)	{ tblidx = FindRowIndexed(pHsm->pIndex, currentstate, ev, extra); }
+	else				{ tblidx = FindRow(pHsm->pFlat, pHsm->szFlat, currentstate, ev, extra); }
+	if(tblidx >= pHsm->szFlat)		{ STATS_MISS(); return currentstate; }
+
+	pPath = &pHsm->pPaths[tblidx];
+	for(action = 0; action < pPath->nExit; ++action)
+	{
+		pHsm->pActions[pPath->first + action](ev, extra);
+	}
+	currentstate = TakeRow(&pHsm->pFlat[tblidx], tblidx, ev, extra);
+	for(action = 0; action < pPath->nEntry; ++action)
+	{
+		pHsm->pActions[pPath->first + pPath->nExit + action](ev, extra);
+	}
+	return currentstate;
+}
+
+/** CWSW State Machine Engine task, for a hierarchical machine.
+ *	Identical to Cwsw_Sme__SME(), except the next state is found via Cwsw_Sme_FindNextStateHsm().
+ */
+pfStateHandler
+Cwsw_Sme__SMEHsm(
+	ptSmeHsm pHsm,
+	pfStateHandler CurrentState,
+	tEvQ_Event ev, uint32_t extra)
+{
+	tSmeMachine m = { NULL, 0, NULL, NULL, NULL, 0 };
+
+	m.pHsm = pHsm;
+	return Step(&m, CurrentState, ev, extra);
+}
+
+
+/** Build the event-interest sets of a machine.
+ *	A state's set holds the event IDs (reason1) of every transition-table row for that state, and
+ *	of every internal reaction declared for that state. A row that does not compare reason1 makes
+ *	its state interested in every event. This is a one-time operation, normally done
+ *	at init.
+ *
+ *	For a hierarchical machine (a pool with `pHsm`), build the sets from the flattened table,
+ *	`pHsm->pFlat`, not from the source table: only there does each simple state carry the rows it
+ *	inherits from its enclosing states. Built from the source table, a state with rows of its own
+ *	would be denied the events its enclosing states react to.
+ *
+ *	@param[out]	pInterest		Interest sets to build. The counters are reset.
+ *	@param[in]	pTblTransition	Transition table of the machine.
+ *	@param[in]	szTblTransition	Size in rows of the transition table.
+ *	@param[in]	pReactions		Internal reactions of the machine's states; may be NULL.
+ *	@param[in]	nReactions		Number of internal reactions.
+ *	@param[in]	pEntries		Caller-provided storage for the sets.
+ *	@param[in]	szEntries		Size in entries of pEntries; one is needed per distinct state.
+ *
+ *	@returns true if the sets were built, false if the arguments are invalid or the storage is too
+ *	small.
+ */
+bool
+Cwsw_Sme_Interest_Build(
+	ptSmeInterest			pInterest,
+	ptTransitionTable		pTblTransition,
+	uint32_t				szTblTransition,
+	tSmeReaction const		*pReactions,
+	uint32_t				nReactions,
+	ptSmeInterestEntry		pEntries,
+	uint32_t				szEntries)
+{
+	ptSmeInterestEntry pEntry;
+	uint32_t idx;
+
+	if(!pInterest || !pEntries)						{ return false; }
+	if(!pTblTransition && szTblTransition)			{ return false; }
+	if(!pReactions && nReactions)					{ return false; }
+
+	pInterest->pEntries   = pEntries;
+	pInterest->nEntries   = 0;
+	pInterest->dispatched = 0;
+	pInterest->skipped    = 0;
+
+	for(idx = 0; idx < szTblTransition; ++idx)
+	{
+		pEntry = AddInterest(pInterest, szEntries, (uintptr_t)pTblTransition[idx].pfCurrent);
+		if(!pEntry)									{ return false; }
+		if(RowMatchMask(&pTblTransition[idx]) & kSmeMatch_Reason1)
+		{
+			SetInterest(pEntry, pTblTransition[idx].reason1);
+		}
+		else
+		{
+			// a row that takes any event makes the state interested in every event.
+			memset(pEntry->events, 0xFF, sizeof(pEntry->events));
+		}
+	}
+	for(idx = 0; idx < nReactions; ++idx)
+	{
+		pEntry = AddInterest(pInterest, szEntries, (uintptr_t)pReactions[idx].state);
+		if(!pEntry)									{ return false; }
+		SetInterest(pEntry, (uint32_t)pReactions[idx].evId);
+	}
+	return true;
+}
+
+/** Check, and count, whether an event should be dispatched to a state.
+ *	For use by a dispatcher that drives a machine through Cwsw_Sme__SME() and friends. The engine
+ *	cannot see the phase of a state that keeps it in a function-local variable, so the caller must
+ *	dispatch regardless while the state is completing its entry or exit action; in run-to-completion
+ *	mode, that is never the case between calls.
+ *
+ *	@returns true if the state reacts to the event, and the event should be dispatched.
+ */
+bool
+Cwsw_Sme_Interest_Check(ptSmeInterest pInterest, pfStateHandler state, tEvQ_EventID evId)
+{
+	if(!pInterest)	{ return true; }
+
+	if(IsInterested(pInterest, state, evId))
+	{
+		INTEREST_COUNT(pInterest->dispatched);
+		return true;
+	}
+	INTEREST_COUNT(pInterest->skipped);
+	return false;
+}
+
+
+/** Initialize an instance pool.
+ *	The caller fills in the machine (pTbl and szTbl, pIndex, or pHsm), the capacity, and the
+ *	per-instance arrays; this resets the pool to hold no instances.
+ *
+ *	@returns true if the pool is usable, false if a required field is missing.
+ */
+bool
+Cwsw_Sme_Pool_Init(ptSmePool pPool)
+{
+	if(!pPool)													{ return false; }
+	if(!pPool->pTbl && !pPool->pIndex && !pPool->pHsm)			{ return false; }
+	if(!pPool->pState || !pPool->pPhase)						{ return false; }
+	if(!pPool->pTimer || !pPool->pEvId)							{ return false; }
+	if(pPool->szUser && !pPool->pUser)							{ return false; }
+
+	pPool->count = 0;
+	return true;
+}
+
+/** Allocate one instance from a pool.
+ *	The instance starts in `initialstate`, with its state phase at kStateUninit so that the state's
+ *	entry action runs on the first step.
+ *
+ *	@returns The new instance's handle, or kSmeInstanceNone if the pool is full.
+ */
+tSmeInstance
+Cwsw_Sme_Pool_Add(ptSmePool pPool, pfStateHandler initialstate)
+{
+	tSmeInstance inst;
+
+	if(!pPool || (pPool->count >= pPool->capacity))	{ return kSmeInstanceNone; }
+
+	inst = pPool->count++;
+	pPool->pState[inst] = initialstate;
+	pPool->pPhase[inst] = kStateUninit;
+	pPool->pTimer[inst] = 0;
+	pPool->pEvId[inst]  = 0;
+	if(pPool->pEntered)
+	{
+		pPool->pEntered[inst] = pfSmeNow ? pfSmeNow() : 0;
+	}
+	if(pPool->szUser)
+	{
+		memset(&pPool->pUser[(size_t)inst * pPool->szUser], 0, pPool->szUser);
+	}
+	return inst;
+}
+
+
+/** CWSW State Machine Engine task, for one instance of a pool.
+ *	This is Cwsw_Sme__SME() for instance-aware machines: the current state is kept in the pool, and
+ *	the state handler is given the instance context.
+ *
+ *	@param[in,out]	pPool	Pool that owns the instance. The instance's current state is updated.
+ *	@param[in]		inst	Instance to drive.
+ *	@param[in]		ev		Event parameter passed to the calling SME by the event dispatcher.
+ *	@param[in]		extra	Extra parameter passed to the calling SME by the event dispatcher.
+ *
+ *	@returns The instance's next state.
+ */
+pfStateHandler
+Cwsw_Sme__SMEInst(
+	ptSmePool pPool, tSmeInstance inst,
+	tEvQ_Event ev, uint32_t extra)
+{
+	if(!pPool || (inst >= pPool->count))	{ return NULL; }
+	return StepInst(pPool, inst, ev, extra);
+}
+
+/** Drive every instance of a pool with the same event.
+ *	Typically used with the SME's periodic alarm event. Instances are stepped in order, so the
+ *	per-instance arrays are walked sequentially.
+ */
+void
+Cwsw_Sme__SMEPool(
+	ptSmePool pPool,
+	tEvQ_Event ev, uint32_t extra)
+{
+	tSmeInstance inst;
+
+	if(!pPool)	{ return; }
+	for(inst = 0; inst < pPool->count; ++inst)
+	{
+		(void)StepInst(pPool, inst, ev, extra);
+	}
+}
+
+
+/** Drive a batch of (instance, event) pairs through a pool.
+ *	Each pair is processed in order, exactly as a call to Cwsw_Sme__SMEInst() would; events for the
+ *	same instance are therefore seen in the order they appear in the batch. This is the entry point
+ *	for feeding the SME straight from an event-queue drain.
+ *
+ *	@param[in,out]	pPool		Pool that owns the instances.
+ *	@param[in]		pItems		(instance, event) pairs to process.
+ *	@param[in]		nItems		Number of pairs.
+ *	@param[out]		pNextStates	If not NULL, receives the instance's state after each pair; NULL for
+ *								a pair whose instance is not allocated.
+ *
+ *	@returns The number of pairs processed; pairs naming an unallocated instance are skipped.
+ */
+uint32_t
+Cwsw_Sme__SMEInstBatch(
+	ptSmePool pPool,
+	tSmeInstEvent const *pItems, uint32_t nItems,
+	pfStateHandler *pNextStates)
+{
+	uint32_t itemidx;
+	uint32_t processed = 0;
+	pfStateHandler nextstate;
+
+	if(!pPool || !pItems)	{ return 0; }
+
+	for(itemidx = 0; itemidx < nItems; ++itemidx)
+	{
+		nextstate = NULL;
+		if(pItems[itemidx].inst < pPool->count)
+		{
+			nextstate = StepInst(pPool, pItems[itemidx].inst, pItems[itemidx].ev, pItems[itemidx].extra);
+			++processed;
+		}
+		if(pNextStates)	{ pNextStates[itemidx] = nextstate; }
+	}
+	return processed;
+}
+
+
+/** Install the time source used to timestamp the SME's instrumentation.
+ *	@param[in] pfNow	Function returning the current time; NULL to timestamp everything as 0.
+ */
+void
+Cwsw_Sme_SetTimeSource(pfSmeTimeSource pfNow)
+{
+	pfSmeNow = pfNow;
+}
+
+
+#if (CWSW_SME_STATS)
+/** Clear a statistics block's counters.
+ *	Call before selecting the block, or from its own thread. The dwell time of each machine's
+ *	current state is measured from now.
+ *
+ *	@returns true if the block is usable; false if a list's size is given without its storage.
+ */
+bool
+Cwsw_Sme_Stats_Init(ptSmeStats pStats)
+{
+	if(!pStats)											{ return false; }
+	if(pStats->nStates && !pStats->pStates)				{ return false; }
+	if(pStats->szRows && !pStats->pRowHits)				{ return false; }
+
+	pStats->steps  = 0;
+	pStats->misses = 0;
+	memset(pStats->latency, 0, sizeof(pStats->latency));
+	if(pStats->pEntries)	{ memset(pStats->pEntries, 0, pStats->nStates * sizeof(*pStats->pEntries)); }
+	if(pStats->pDwell)		{ memset(pStats->pDwell, 0, (size_t)pStats->nStates * SME_STATS_BUCKETS * sizeof(*pStats->pDwell)); }
+	if(pStats->pRowHits)	{ memset(pStats->pRowHits, 0, pStats->szRows * sizeof(*pStats->pRowHits)); }
+	return true;
+}
+
+/** Select the statistics block for the calling thread.
+ *	Every SME step the thread runs from now on is counted in this block; NULL stops counting.
+ *	Select a different block in each thread.
+ */
+void
+Cwsw_Sme_Stats_Select(ptSmeStats pStats)
+{
+	pStatsSel = pStats;
+}
+
+/** Name the plain machine the calling thread steps next, for its dwell time.
+ *	A pool keeps the entry time of each instance in its `pEntered` array. A plain machine (driven
+ *	by Cwsw_Sme__SME() and the like) has nowhere to keep it, so its caller supplies one
+ *	tCwswClockTics per machine, and names it before stepping that machine; it stays named for the
+ *	thread's later steps, until another is named. NULL, the default, keeps no dwell time for plain
+ *	machines.
+ */
+void
+Cwsw_Sme_Stats_Machine(tCwswClockTics *pEntered)
+{
+	pStatsPlain = pEntered;
+}
+
+/** Add a statistics block's counters into another.
+ *	May be called from any thread, while the source block is in use: no lock is taken, and the
+ *	source is not modified. Each counter is read atomically, but the counters are not read at one
+ *	instant, so they may be a few events apart. To merge the blocks of several threads, clear the
+ *	destination with Cwsw_Sme_Stats_Init(), then add each block in turn.
+ *
+ *	@param[in,out]	pDst	Destination; its lists must be at least as long as the source's.
+ *	@param[in]		pSrc	Block to read.
+ *
+ *	@returns true if the counters were added; false if the destination is too small.
+ */
+bool
+Cwsw_Sme_Stats_Snapshot(ptSmeStats pDst, tSmeStats const *pSrc)
+{
+	uint32_t idx;
+
+	if(!pDst || !pSrc)	{ return false; }
+	if(pSrc->pEntries && (!pDst->pEntries || (pDst->nStates < pSrc->nStates)))		{ return false; }
+	if(pSrc->pDwell && (!pDst->pDwell || (pDst->nStates < pSrc->nStates)))			{ return false; }
+	if(pSrc->pRowHits && (!pDst->pRowHits || (pDst->szRows < pSrc->szRows)))		{ return false; }
+
+	pDst->steps  += STATS_LOAD(pSrc->steps);
+	pDst->misses += STATS_LOAD(pSrc->misses);
+	for(idx = 0; idx < SME_STATS_BUCKETS; ++idx)
+	{
+		pDst->latency[idx] += STATS_LOAD(pSrc->latency[idx]);
+	}
+	for(idx = 0; pSrc->pEntries && (idx < pSrc->nStates); ++idx)
+	{
+		pDst->pEntries[idx] += STATS_LOAD(pSrc->pEntries[idx]);
+	}
+	for(idx = 0; pSrc->pDwell && (idx < (pSrc->nStates * SME_STATS_BUCKETS)); ++idx)
+	{
+		pDst->pDwell[idx] += STATS_LOAD(pSrc->pDwell[idx]);
+	}
+	for(idx = 0; pSrc->pRowHits && (idx < pSrc->szRows); ++idx)
+	{
+		pDst->pRowHits[idx] += STATS_LOAD(pSrc->pRowHits[idx]);
+	}
+	return true;
+}
+#endif
+
+
+#if (CWSW_SME_TRACE)
+/** Drain records from the transition trace ring.
+ *	Intended to be called from a background or lower-priority context, off the transition path.
+ *	Only one context may drain the ring.
+ *
+ *	@param[out]	pDst	Destination for the records, oldest first.
+ *	@param[in]	maxrecs	Capacity in records of pDst.
+ *
+ *	@returns The number of records copied to pDst.
+ */
+uint32_t
+Cwsw_Sme_Trace_Drain(ptSmeTraceRecord pDst, uint32_t maxrecs)
+{
+	uint32_t tail = TRACE_LOAD(tracetail);
+	uint32_t head;
+	uint32_t count = 0;
+
+	if(!pDst)	{ return 0; }
+
+	head = TRACE_ACQUIRE(tracehead);
+	while((count < maxrecs) && (tail != head))
+	{
+		pDst[count++] = tracering[tail & TRACE_MASK];
+		++tail;
+	}
+	TRACE_RELEASE(tracetail, tail);		// hand the copied slots back to the writer
+	return count;
+}
+
+/** Number of trace records dropped because the ring was full. */
+uint32_t
+Cwsw_Sme_Trace_Lost(void)
+{
+	return TRACE_LOAD(tracelost);
+}
+
+/** Decode one trace record into text.
+ *	The SME doesn't know the names of the states; handlers are shown by address, for resolution
+ *	against the map file.
+ *
+ *	@returns The return value of snprintf().
+ */
+int
+Cwsw_Sme_Trace_Decode(tSmeTraceRecord const *pRec, char *buf, size_t szbuf)
+{
+	if(!pRec || !buf)	{ return -1; }
+	return snprintf(buf, szbuf,
+		"%ld: row %lu, 0x%" PRIxPTR " -> 0x%" PRIxPTR ", reasons %ld/%lu/%lu",
+		(long)pRec->timestamp, (unsigned long)pRec->row,
+		(uintptr_t)pRec->pfFrom, (uintptr_t)pRec->pfTo,
+		(long)pRec->evId, (unsigned long)pRec->evData, (unsigned long)pRec->extra);
 }
+#endif
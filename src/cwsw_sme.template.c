@@ -8,7 +8,9 @@
  *
  *	The design is such that you'll probably want a fairly small, constraint SM to control - the
  *	vision we put into play was to control a stoplight, and/or read and debounce hardware buttons.
- *	Larger / nested state machines can easily be accommodated by using SMEs that control sub-SMEs.
+ *	Larger / nested state machines can easily be accommodated by using SMEs that control sub-SMEs,
+ *	or, without the extra engine pass per level, by declaring the nesting in a tSmeHsmState table
+ *	and driving the machine with Cwsw_Sme__SMEHsm().
  *
  *	\copyright
  *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
@@ -28,6 +30,7 @@
 
 // ----	Module Headers --------------------------
 #include "cwsw_sme.h"
+#include "cwsw_sme_wheel.h"
 
 
 // ============================================================================
@@ -38,6 +41,9 @@
  *	You will want to identify your own states and their names. This enumeration shows only one way
  *	to do it, and is pulled from the demonstration app (which implements one single-direction green-
  *	yellow-red stop light).
+ *
+ *	With a packed transition table (tSmePackedTable), these are also the state indices held in its
+ *	rows, and the order of its state list; kStateNone, index 0, is the list's NULL entry.
  */
 typedef enum eSmStates { kStateNone, kStateRed, kStateGreen, kStateYellow } tSmStates;
 
@@ -63,6 +69,25 @@ tCwswSwAlarm	MyComponent_tmr_SME = {
 
 };
 
+/* for a tickless SME, the alarm above is not reloaded every 20 ms; instead, the SME's task calls
+ * Cwsw_Sme_Tickless_Service() each time the alarm matures, which delivers the expired timeouts and
+ * re-arms the alarm, as a one-shot, for the next deadline on the wheel. whatever posts an event to
+ * the SME calls Cwsw_Sme_Tickless_Kick() so that the task runs at once. the driver arms and disarms
+ * the alarm only through CWSW_SME_ALARM_ARM() and CWSW_SME_ALARM_DISARM(); if your swtimer
+ * component doesn't count `tm` down as the default adapter assumes, define those to use its API.
+ */
+#if 0
+tSmeTickless	MyComponent_tickless_SME = {
+	/* .pAlarm		= */&MyComponent_tmr_SME,
+	/* .pWheel		= */&MyComponent_wheel,		//!< the tSmeWheel attached to the pool (see MyComponent_pool, below).
+	/* .maxsleep	= */0,					//!< with nothing pending, the alarm is disabled until kicked.
+	/* .deadline	= */0,
+	/* .armed		= */false,
+	/* .rearms		= */0,
+	/* .kicks		= */0
+};
+#endif
+
 
 // ============================================================================
 // ----	Module-level Variables ------------------------------------------------
@@ -196,7 +221,8 @@ template_StateHandler(ptEvQ_Event pev, uint32_t *pextra)
 
 	case kStateOperational:
 		/* normal state behavior here, including handling in-state reactions to events
-		 *	if there is a guard condition, evaluate that here.
+		 *	if there is a guard condition, evaluate that here - or, better, put it in the `pfGuard`
+		 *	field of the transition-table row, where the SME calls it only if the exit reasons match.
 		 */
 
 		// add here, any other exit reasons not covered by in-state reactions above.
@@ -228,3 +254,87 @@ template_StateHandler(ptEvQ_Event pev, uint32_t *pextra)
 }
 #endif
 
+
+#if 0
+/* instance-aware edition of the template state handler. everything the template keeps in function-
+ * local `static` variables lives in the instance pool instead, so the same handler can drive any
+ * number of identical machines. list it in the transition table as SME_INST_STATE(...), and drive
+ * the machines with Cwsw_Sme__SMEInst() or Cwsw_Sme__SMEPool().
+ */
+static tStateReturnCodes
+template_InstStateHandler(ptSmeInstCtx pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	switch(SME_INST_PHASE(pctx))
+	{
+	case kStateUninit:	/* on 1st entry, execute on-entry action */
+	case kStateAbort:	/* upon return to this state after previous normal exit, execute on-entry action */
+	default:			/* for any unexpected value, restart this state. */
+		SME_INST_EVID(pctx) = pev->evId;	// save exit Reason1
+		/* with a timing wheel attached to the pool, the wheel posts evMyState_Timeout when the time
+		 * is up, and the state need not be called at all until then. without one, arm the
+		 * instance's timer and poll it, as the single-instance template does.
+		 * the wheel has no lock: arm it only from the thread that advances it, which rules out a
+		 * pool run on the scheduler's workers (Cwsw_Sme_Sched_Create() refuses a pool with a wheel).
+		 */
+		if(pctx->pPool->pWheel)
+		{
+			Cwsw_Sme_Wheel_Arm(pctx->pPool->pWheel, pctx->inst, tmr1000ms, evMyState_Timeout);
+		}
+		else
+		{
+			Set(Cwsw_Clock, SME_INST_TIMER(pctx), tmr1000ms);
+		}
+		SME_INST_PHASE(pctx) = kStateOperational;
+		break;
+
+	case kStateOperational:
+		if(pctx->pPool->pWheel ?
+			(pev->evId == evMyState_Timeout) :
+			(Cwsw_GetTimeLeft(SME_INST_TIMER(pctx)) <= 0) )
+		{
+			++SME_INST_PHASE(pctx);
+		}
+		break;
+
+	case kStateExit:
+		pev->evId = SME_INST_EVID(pctx);
+		pev->evData = 0;
+		*pextra = 0;
+		/* unlike the single-instance template, the phase must move past kStateExit here: it is
+		 * what tells the SME that the exit action is done, and it is also the phase the next state
+		 * of this instance starts from, where kStateFinished runs the entry action.
+		 */
+		SME_INST_PHASE(pctx) = kStateFinished;
+		break;
+	}
+
+	// the next line is part of the template and should not be touched.
+	return SME_INST_PHASE(pctx);
+}
+
+/* storage for the instance pool. each array holds one element per instance. */
+#define kMyComponent_Instances	(1000)
+static pfStateHandler		MyComponent_state[kMyComponent_Instances];
+static tStateReturnCodes	MyComponent_phase[kMyComponent_Instances];
+static tCwswClockTics		MyComponent_timer[kMyComponent_Instances];
+static tEvQ_EventID			MyComponent_evid[kMyComponent_Instances];
+
+static tSmePool MyComponent_pool = {
+	/* .pTbl		= */tblTransitions,
+	/* .szTbl		= */TABLE_SIZE(tblTransitions),
+	/* .pIndex		= */NULL,
+	/* .capacity	= */kMyComponent_Instances,
+	/* .count		= */0,
+	/* .pState		= */MyComponent_state,
+	/* .pPhase		= */MyComponent_phase,
+	/* .pTimer		= */MyComponent_timer,
+	/* .pEvId		= */MyComponent_evid,
+	/* .pUser		= */NULL,
+	/* .szUser		= */0,
+	/* .maxchain	= */0,		// stepwise; set nonzero to run each transition to completion within one step
+	/* .pInterest	= */NULL,	// set to the result of Cwsw_Sme_Interest_Build() to skip events the states ignore
+	/* .pHsm		= */NULL,
+	/* .pWheel		= */NULL,	// set to a tSmeWheel to have state timeouts posted rather than polled
+	/* .pEntered	= */NULL	// with CWSW_SME_STATS, set to a per-instance array to measure dwell time
+};
+#endif
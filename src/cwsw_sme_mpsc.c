@@ -0,0 +1,304 @@
+/** @file
+ *	@brief	Lock-free, bounded, multi-producer / single-consumer event queues for SME instances.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdatomic.h>
+#include <stddef.h>		/* offsetof() */
+#include <stdlib.h>		/* calloc(), free() */
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme_mpsc.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/** Size of a cache line; the producer and consumer positions of a queue each get their own. */
+#define CACHE_LINE		(64)
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/** One slot of a queue.
+ *	For the slot at position `pos`, `seq` is `pos` while the slot is free, `pos + 1` once it is
+ *	committed, and `pos + size` once the consumer has released it for the next lap.
+ */
+typedef struct sSmeMpscSlot {
+	atomic_uint		seq;
+	tSmeMpscEntry	entry;
+} tSmeMpscSlot;
+
+/** Positions of one instance's queue. */
+typedef struct sSmeMpscQueue {
+	atomic_uint		enqueue;	// next position to reserve; shared by the producers
+	uint8_t			pad1[CACHE_LINE - sizeof(atomic_uint)];
+	atomic_uint		dequeue;	// next position to consume; written by the consumer alone
+	uint8_t			pad2[CACHE_LINE - sizeof(atomic_uint)];
+} tSmeMpscQueue;
+
+struct sSmeMpsc {
+	ptSmePool			pPool;
+	uint32_t			mask;		// slots per queue, less 1
+	tSmeMpscQueue		*pQueues;	// one per instance
+	tSmeMpscSlot		*pSlots;	// mask + 1 per instance
+	atomic_uint_fast64_t rejected;
+};
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+static tSmeMpscSlot *
+SlotAt(ptSmeMpsc pMpsc, tSmeInstance inst, unsigned pos)
+{
+	return &pMpsc->pSlots[((size_t)inst * (pMpsc->mask + 1)) + (pos & pMpsc->mask)];
+}
+
+static void
+FreeMpsc(ptSmeMpsc pMpsc)
+{
+	free(pMpsc->pQueues);
+	free(pMpsc->pSlots);
+	free(pMpsc);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/** Create a queue for each instance of a pool.
+ *	@param[in]	pPool		Initialized pool.
+ *	@param[in]	szQueue		Capacity in events of each queue; a power of 2.
+ *
+ *	@returns The queues, or NULL if the arguments are invalid or memory is not available.
+ */
+ptSmeMpsc
+Cwsw_Sme_Mpsc_Create(ptSmePool pPool, uint32_t szQueue)
+{
+	ptSmeMpsc pMpsc;
+	size_t idx;
+	size_t nslots;
+
+	if(!pPool || !pPool->capacity)				{ return NULL; }
+	if(!szQueue || (szQueue & (szQueue - 1)))	{ return NULL; }
+
+	pMpsc = (ptSmeMpsc)calloc(1, sizeof(*pMpsc));
+	if(!pMpsc)									{ return NULL; }
+
+	nslots = (size_t)pPool->capacity * szQueue;
+	pMpsc->pPool	= pPool;
+	pMpsc->mask		= szQueue - 1;
+	pMpsc->pQueues	= (tSmeMpscQueue *)calloc(pPool->capacity, sizeof(*pMpsc->pQueues));
+	pMpsc->pSlots	= (tSmeMpscSlot *)calloc(nslots, sizeof(*pMpsc->pSlots));
+	if(!pMpsc->pQueues || !pMpsc->pSlots)
+	{
+		FreeMpsc(pMpsc);
+		return NULL;
+	}
+
+	for(idx = 0; idx < pPool->capacity; ++idx)
+	{
+		atomic_init(&pMpsc->pQueues[idx].enqueue, 0);
+		atomic_init(&pMpsc->pQueues[idx].dequeue, 0);
+	}
+	for(idx = 0; idx < nslots; ++idx)
+	{
+		atomic_init(&pMpsc->pSlots[idx].seq, (unsigned)(idx & pMpsc->mask));
+	}
+	atomic_init(&pMpsc->rejected, 0);
+	return pMpsc;
+}
+
+/** Reserve the next slot of an instance's queue.
+ *	May be called from any thread. The caller fills in the returned entry, then passes it to
+ *	Cwsw_Sme_Mpsc_Commit().
+ *
+ *	@returns The reserved entry; NULL if the instance's queue is full, or the instance is not
+ *	allocated.
+ */
+ptSmeMpscEntry
+Cwsw_Sme_Mpsc_Reserve(ptSmeMpsc pMpsc, tSmeInstance inst)
+{
+	tSmeMpscQueue *pQueue;
+	tSmeMpscSlot *pSlot;
+	unsigned pos;
+	int diff;
+
+	if(!pMpsc || (inst >= pMpsc->pPool->count))	{ return NULL; }
+
+	pQueue = &pMpsc->pQueues[inst];
+	pos = atomic_load_explicit(&pQueue->enqueue, memory_order_relaxed);
+	for(;;)
+	{
+		pSlot = SlotAt(pMpsc, inst, pos);
+		diff = (int)(atomic_load_explicit(&pSlot->seq, memory_order_acquire) - pos);
+		if(diff == 0)
+		{
+			// the slot is free for this lap; claim it, unless another producer got there first.
+			if(atomic_compare_exchange_weak_explicit(&pQueue->enqueue, &pos, pos + 1,
+				memory_order_relaxed, memory_order_relaxed))
+			{
+				return &pSlot->entry;
+			}
+		}
+		else if(diff < 0)
+		{
+			// the slot still holds the previous lap's event: the queue is full.
+			(void)atomic_fetch_add_explicit(&pMpsc->rejected, 1, memory_order_relaxed);
+			return NULL;
+		}
+		else
+		{
+			pos = atomic_load_explicit(&pQueue->enqueue, memory_order_relaxed);
+		}
+	}
+}
+
+/** Commit a reserved entry, making it visible to the consumer. */
+void
+Cwsw_Sme_Mpsc_Commit(ptSmeMpsc pMpsc, ptSmeMpscEntry pEntry)
+{
+	tSmeMpscSlot *pSlot;
+
+	if(!pMpsc || !pEntry)	{ return; }
+
+	pSlot = (tSmeMpscSlot *)(void *)((char *)pEntry - offsetof(tSmeMpscSlot, entry));
+	atomic_store_explicit(&pSlot->seq, atomic_load_explicit(&pSlot->seq, memory_order_relaxed) + 1, memory_order_release);
+}
+
+/** Post an event to an instance's queue: reserve, fill in, commit.
+ *	@returns true if the event was queued; false if the queue is full.
+ */
+bool
+Cwsw_Sme_Mpsc_Post(ptSmeMpsc pMpsc, tSmeInstance inst, tEvQ_Event ev, uint32_t extra)
+{
+	ptSmeMpscEntry pEntry = Cwsw_Sme_Mpsc_Reserve(pMpsc, inst);
+
+	if(!pEntry)	{ return false; }
+	pEntry->ev = ev;
+	pEntry->extra = extra;
+	Cwsw_Sme_Mpsc_Commit(pMpsc, pEntry);
+	return true;
+}
+
+/** Oldest committed event of an instance's queue, left in place.
+ *	For the consumer only. The entry stays valid until Cwsw_Sme_Mpsc_Release().
+ *
+ *	@returns The entry; NULL if there is no committed event.
+ */
+ptSmeMpscEntry
+Cwsw_Sme_Mpsc_Peek(ptSmeMpsc pMpsc, tSmeInstance inst)
+{
+	tSmeMpscSlot *pSlot;
+	unsigned pos;
+
+	if(!pMpsc || (inst >= pMpsc->pPool->capacity))	{ return NULL; }
+
+	pos = atomic_load_explicit(&pMpsc->pQueues[inst].dequeue, memory_order_relaxed);
+	pSlot = SlotAt(pMpsc, inst, pos);
+	if(atomic_load_explicit(&pSlot->seq, memory_order_acquire) != (pos + 1))	{ return NULL; }
+	return &pSlot->entry;
+}
+
+/** Release the oldest event of an instance's queue, returned by Cwsw_Sme_Mpsc_Peek(). */
+void
+Cwsw_Sme_Mpsc_Release(ptSmeMpsc pMpsc, tSmeInstance inst)
+{
+	tSmeMpscQueue *pQueue;
+	unsigned pos;
+
+	if(!pMpsc || (inst >= pMpsc->pPool->capacity))	{ return; }
+
+	pQueue = &pMpsc->pQueues[inst];
+	pos = atomic_load_explicit(&pQueue->dequeue, memory_order_relaxed);
+	atomic_store_explicit(&SlotAt(pMpsc, inst, pos)->seq, pos + pMpsc->mask + 1, memory_order_release);
+	atomic_store_explicit(&pQueue->dequeue, pos + 1, memory_order_relaxed);
+}
+
+/** Does an instance's queue hold no committed event?
+ *	Exact for the consumer. From any other thread, it is only a hint, as the consumer may be
+ *	running concurrently.
+ */
+bool
+Cwsw_Sme_Mpsc_IsEmpty(ptSmeMpsc pMpsc, tSmeInstance inst)
+{
+	return (Cwsw_Sme_Mpsc_Peek(pMpsc, inst) == NULL);
+}
+
+/** Run an instance's queued events through the SME.
+ *	Each event is presented to Cwsw_Sme__SMEInst() straight from its slot, and the slot is released
+ *	as soon as the event has run, so producers can refill it while the rest of the batch runs.
+ *	Events posted by the state handlers themselves are run in the same call, within `maxevents`.
+ *
+ *	@param[in]	maxevents	Bound on the events run; 0 for no bound beyond the queue's capacity.
+ *
+ *	@returns The number of events run.
+ */
+uint32_t
+Cwsw_Sme_Mpsc_Drain(ptSmeMpsc pMpsc, tSmeInstance inst, uint32_t maxevents)
+{
+	ptSmeMpscEntry pEntry;
+	uint32_t ran = 0;
+
+	if(!maxevents)	{ maxevents = pMpsc ? (pMpsc->mask + 1) : 0; }
+
+	while((ran < maxevents) && ((pEntry = Cwsw_Sme_Mpsc_Peek(pMpsc, inst)) != NULL))
+	{
+		(void)Cwsw_Sme__SMEInst(pMpsc->pPool, inst, pEntry->ev, pEntry->extra);
+		Cwsw_Sme_Mpsc_Release(pMpsc, inst);
+		++ran;
+	}
+	return ran;
+}
+
+/** Run the queued events of every instance of the pool, up to `maxevents` per instance.
+ *	@returns The number of events run.
+ */
+uint32_t
+Cwsw_Sme_Mpsc_DrainPool(ptSmeMpsc pMpsc, uint32_t maxevents)
+{
+	tSmeInstance inst;
+	uint32_t ran = 0;
+
+	if(!pMpsc)	{ return 0; }
+
+	for(inst = 0; inst < pMpsc->pPool->count; ++inst)
+	{
+		ran += Cwsw_Sme_Mpsc_Drain(pMpsc, inst, maxevents);
+	}
+	return ran;
+}
+
+/** Number of events refused because a queue was full. */
+uint64_t
+Cwsw_Sme_Mpsc_Rejected(ptSmeMpsc pMpsc)
+{
+	if(!pMpsc)	{ return 0; }
+	return atomic_load_explicit(&pMpsc->rejected, memory_order_relaxed);
+}
+
+/** Release the queues. Events still queued are discarded. */
+void
+Cwsw_Sme_Mpsc_Destroy(ptSmeMpsc pMpsc)
+{
+	if(!pMpsc)	{ return; }
+	FreeMpsc(pMpsc);
+}
@@ -0,0 +1,356 @@
+/** @file
+ *	@brief	Deterministic, faster-than-real-time replay of scripted button input into an SME.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE	200112L	/* mmap(), posix_madvise() */
+#endif
+#include <stdio.h>		/* fopen(), fread() */
+#include <stdlib.h>		/* malloc(), free() */
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>		/* open() */
+#include <sys/mman.h>	/* mmap() */
+#include <sys/stat.h>	/* fstat() */
+#include <unistd.h>		/* close() */
+#define REPLAY_MMAP		(1)
+#else
+#define REPLAY_MMAP		(0)
+#endif
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme_replay.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+#define FNV_OFFSET		(14695981039346656037ull)
+#define FNV_PRIME		(1099511628211ull)
+
+/** Size of each read, when a script is streamed rather than mapped. */
+#define REPLAY_CHUNK	(65536)
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+/** The replay whose clock Cwsw_Sme_Replay_Clock() reports: the one most recently initialized. */
+static ptSmeReplay pClockReplay = NULL;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+static tCwswClockTics
+TicsAfter(tCwswClockTics time, tCwswClockTics delay)
+{
+	return (tCwswClockTics)((uint32_t)time + (uint32_t)delay);
+}
+
+/** Is `time` at or before `limit`? Safe across wraparound of the clock. */
+static bool
+NotAfter(tCwswClockTics time, tCwswClockTics limit)
+{
+	return ((int32_t)((uint32_t)limit - (uint32_t)time) >= 0);
+}
+
+/** Run the virtual clock forward to `until`, delivering every tick that falls due on the way. */
+static void
+AdvanceTo(ptSmeReplay pReplay, tCwswClockTics until)
+{
+	while((pReplay->period > 0) && NotAfter(pReplay->nexttick, until))
+	{
+		pReplay->now = pReplay->nexttick;
+		if(pReplay->pWheel)	{ (void)Cwsw_Sme_Wheel_Advance(pReplay->pWheel, pReplay->now); }
+		if(pReplay->pfTick)	{ pReplay->pfTick(pReplay->pCtx, pReplay->now); }
+		++pReplay->ticks;
+		pReplay->nexttick = TicsAfter(pReplay->nexttick, pReplay->period);
+	}
+	pReplay->now = until;
+	if(pReplay->pWheel)	{ (void)Cwsw_Sme_Wheel_Advance(pReplay->pWheel, pReplay->now); }
+}
+
+/** Parse a time value: binary, as the design notes define it; or, as extensions, decimal with a
+ *	`0d` prefix or hexadecimal with `0x`. A `0b` prefix is accepted on binary values too.
+ *	@returns true if the whole token is a valid value that fits in a tCwswClockTics.
+ */
+static bool
+ParseTime(char const *pTok, uint32_t len, tCwswClockTics *pValue)
+{
+	uint32_t base = 2;
+	uint32_t idx = 0;
+	uint32_t digit;
+	uint64_t value = 0;
+
+	if((len > 2) && (pTok[0] == '0'))
+	{
+		switch(pTok[1])
+		{
+		case 'b':	case 'B':	base = 2;	idx = 2;	break;
+		case 'd':	case 'D':	base = 10;	idx = 2;	break;
+		case 'x':	case 'X':	base = 16;	idx = 2;	break;
+		default:										break;
+		}
+	}
+	if(idx >= len)	{ return false; }
+
+	for(; idx < len; ++idx)
+	{
+		char c = pTok[idx];
+		if((c >= '0') && (c <= '9'))		{ digit = (uint32_t)(c - '0'); }
+		else if((c >= 'a') && (c <= 'f'))	{ digit = (uint32_t)(c - 'a') + 10; }
+		else if((c >= 'A') && (c <= 'F'))	{ digit = (uint32_t)(c - 'A') + 10; }
+		else								{ return false; }
+		if(digit >= base)					{ return false; }
+
+		value = (value * base) + digit;
+		if(value > INT32_MAX)				{ return false; }
+	}
+	*pValue = (tCwswClockTics)value;
+	return true;
+}
+
+/** A token has ended: apply a time value, or note the end of a contact string. */
+static void
+EndToken(ptSmeReplay pReplay)
+{
+	tCwswClockTics delay;
+
+	if(!pReplay->intoken)	{ return; }
+
+	if(pReplay->wanttime)
+	{
+		if(ParseTime(pReplay->token, pReplay->toklen, &delay))	{ AdvanceTo(pReplay, TicsAfter(pReplay->now, delay)); }
+		else													{ ++pReplay->errors; }
+	}
+	pReplay->wanttime = !pReplay->wanttime;
+	pReplay->intoken = false;
+	pReplay->toklen = 0;
+}
+
+/** Deliver one contact sample at the current time, then let it hold for its duration. */
+static void
+Sample(ptSmeReplay pReplay, char c)
+{
+	if((c < '0') || (c > '9'))
+	{
+		++pReplay->errors;
+		return;
+	}
+	if(pReplay->pfInput)	{ pReplay->pfInput(pReplay->pCtx, pReplay->now, (uint8_t)(c - '0')); }
+	++pReplay->samples;
+	AdvanceTo(pReplay, TicsAfter(pReplay->now, pReplay->sample));
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/** Prepare a replay, with its virtual clock at `start`.
+ *	This replay's clock becomes the one reported by Cwsw_Sme_Replay_Clock().
+ *
+ *	@returns true if the replay is usable; false if the sample duration or the period is invalid.
+ */
+bool
+Cwsw_Sme_Replay_Init(ptSmeReplay pReplay, tCwswClockTics start)
+{
+	if(!pReplay)												{ return false; }
+	if((pReplay->sample < 1) || (pReplay->period < 0))			{ return false; }
+
+	pReplay->now		= start;
+	pReplay->nexttick	= TicsAfter(start, pReplay->period);
+	pReplay->digest		= FNV_OFFSET;
+	pReplay->samples	= 0;
+	pReplay->ticks		= 0;
+	pReplay->errors		= 0;
+	pReplay->line		= 1;
+	pReplay->wanttime	= true;
+	pReplay->intoken	= false;
+	pReplay->incomment	= false;
+	pReplay->toklen		= 0;
+	pClockReplay = pReplay;
+	return true;
+}
+
+/** Feed a piece of the script to the replay.
+ *	The script may be split anywhere, even within a token; each piece continues where the last
+ *	one stopped. Call Cwsw_Sme_Replay_Finish() after the last piece.
+ *
+ *	@returns The number of characters consumed; always `len`.
+ */
+size_t
+Cwsw_Sme_Replay_Feed(ptSmeReplay pReplay, char const *pText, size_t len)
+{
+	size_t idx;
+
+	if(!pReplay || !pText)	{ return 0; }
+
+	for(idx = 0; idx < len; ++idx)
+	{
+		char c = pText[idx];
+
+		if(c == '\n')	{ ++pReplay->line; }
+		if(pReplay->incomment)
+		{
+			if(c == '\n')	{ pReplay->incomment = false; }
+			continue;
+		}
+
+		switch(c)
+		{
+		case '#':
+			EndToken(pReplay);
+			pReplay->incomment = true;
+			break;
+
+		case ' ': case '\t': case '\r': case '\n': case '\f': case '\v':
+			EndToken(pReplay);
+			break;
+
+		default:
+			pReplay->intoken = true;
+			if(!pReplay->wanttime)
+			{
+				Sample(pReplay, c);
+			}
+			else if(pReplay->toklen < SME_REPLAY_MAXTOKEN)
+			{
+				pReplay->token[pReplay->toklen++] = c;
+			}
+			else
+			{
+				// too long to be a time value; let ParseTime() reject what was kept.
+				pReplay->token[0] = '?';
+			}
+			break;
+		}
+	}
+	return len;
+}
+
+/** Finish the script: apply a token left open at the end of the last piece. */
+void
+Cwsw_Sme_Replay_Finish(ptSmeReplay pReplay)
+{
+	if(!pReplay)	{ return; }
+	EndToken(pReplay);
+	pReplay->incomment = false;
+}
+
+/** Replay a whole script file, then finish.
+ *	On POSIX hosts the file is mapped into memory and fed in one piece; elsewhere, or if it can't be
+ *	mapped, it is read and fed in chunks.
+ *
+ *	@returns true if the whole file was read.
+ */
+bool
+Cwsw_Sme_Replay_File(ptSmeReplay pReplay, char const *path)
+{
+	char *pChunk;
+	FILE *pFile;
+	size_t got;
+	bool ok;
+
+	if(!pReplay || !path)	{ return false; }
+
+#if (REPLAY_MMAP)
+	{
+		int fd = open(path, O_RDONLY);
+		struct stat st;
+		void *pMap;
+
+		if(fd < 0)	{ return false; }
+		if((fstat(fd, &st) == 0) && (st.st_size > 0))
+		{
+			pMap = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(pMap != MAP_FAILED)
+			{
+				(void)posix_madvise(pMap, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+				(void)Cwsw_Sme_Replay_Feed(pReplay, (char const *)pMap, (size_t)st.st_size);
+				(void)munmap(pMap, (size_t)st.st_size);
+				(void)close(fd);
+				Cwsw_Sme_Replay_Finish(pReplay);
+				return true;
+			}
+		}
+		(void)close(fd);
+	}
+#endif
+
+	pFile = fopen(path, "rb");
+	if(!pFile)	{ return false; }
+	pChunk = (char *)malloc(REPLAY_CHUNK);
+	if(!pChunk)
+	{
+		(void)fclose(pFile);
+		return false;
+	}
+	while((got = fread(pChunk, 1, REPLAY_CHUNK, pFile)) > 0)
+	{
+		(void)Cwsw_Sme_Replay_Feed(pReplay, pChunk, got);
+	}
+	ok = !ferror(pFile);
+	free(pChunk);
+	(void)fclose(pFile);
+	Cwsw_Sme_Replay_Finish(pReplay);
+	return ok;
+}
+
+/** Virtual clock of the current replay.
+ *	Suitable for Cwsw_Sme_SetTimeSource(), and for standing in for Cwsw_Clock in a replay build.
+ *
+ *	@returns The current replay's virtual time; 0 if no replay has been initialized.
+ */
+tCwswClockTics
+Cwsw_Sme_Replay_Clock(void)
+{
+	return pClockReplay ? pClockReplay->now : 0;
+}
+
+/** Fold an observation into the replay's digest, along with the virtual time it was made. */
+void
+Cwsw_Sme_Replay_Record(ptSmeReplay pReplay, void const *pData, size_t len)
+{
+	uint8_t const *pByte = (uint8_t const *)pData;
+	uint32_t now;
+	uint64_t hash;
+	size_t idx;
+
+	if(!pReplay)	{ return; }
+
+	hash = pReplay->digest;
+	now = (uint32_t)pReplay->now;
+	for(idx = 0; idx < sizeof(now); ++idx)
+	{
+		hash = (hash ^ (uint8_t)(now >> (8 * idx))) * FNV_PRIME;
+	}
+	for(idx = 0; pByte && (idx < len); ++idx)
+	{
+		hash = (hash ^ pByte[idx]) * FNV_PRIME;
+	}
+	pReplay->digest = hash;
+}
+
+/** Digest of everything recorded so far; compare against a known-good run. */
+uint64_t
+Cwsw_Sme_Replay_Digest(ptSmeReplay pReplay)
+{
+	return pReplay ? pReplay->digest : 0;
+}
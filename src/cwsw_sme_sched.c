@@ -0,0 +1,418 @@
+/** @file
+ *	@brief	Host-side, multi-threaded scheduler for pools of SME instances.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <pthread.h>
+#include <sched.h>		/* sched_yield() */
+#include <stdatomic.h>
+#include <stdlib.h>		/* calloc(), free() */
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme_sched.h"
+#include "cwsw_sme_mpsc.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/* the trace ring has a single writer, and the workers step machines on several threads at once. */
+#if (CWSW_SME_TRACE)
+#error "the transition trace ring has one writer; build the scheduler with CWSW_SME_TRACE off"
+#endif
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/** One worker thread and its run queue.
+ *	The run queue is a ring of instance handles. The owner takes from the head; thieves take from
+ *	the tail.
+ */
+typedef struct sSmeSchedWorker {
+	struct sSmeSched	*pSched;
+	uint32_t			id;
+	pthread_t			thread;
+	pthread_mutex_t		lock;		// protects the run queue
+	tSmeInstance		*pRing;		// run queue; holds every instance of the pool at most once
+	uint32_t			head;
+	uint32_t			count;
+} tSmeSchedWorker;
+
+struct sSmeSched {
+	ptSmePool			pPool;
+	uint32_t			nWorkers;
+	tSmeSchedWorker		*pWorkers;
+
+	ptSmeMpsc			pInbox;		// per-instance inboxes
+
+	/* events posted to each instance and not yet run. the poster that raises it from 0 places the
+	 * instance on a run queue, and the worker that brings it back to 0 releases it; in between, the
+	 * instance is on a run queue or running, which is what keeps it from running on two threads at
+	 * once. the count only changes by read-modify-write, so the handoff needs no fences.
+	 */
+	atomic_uint			*pPending;
+
+	atomic_bool			running;
+	atomic_uint			queued;			// instances on run queues
+	atomic_uint			sleepers;		// workers parked, waiting for work
+	atomic_uint_fast64_t outstanding;	// events posted and not yet run
+	pthread_mutex_t		parklock;
+	pthread_cond_t		parkcond;		// signaled when work is queued
+	pthread_cond_t		drainedcond;	// signaled when the last outstanding event has run
+	bool				synced;			// the three above and every worker's lock are initialized
+
+	atomic_uint_fast64_t events;
+	atomic_uint_fast64_t runs;
+	atomic_uint_fast64_t steals;
+	atomic_uint_fast64_t rejected;
+};
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/** Place an instance on a worker's run queue, and wake a parked worker if there is one. */
+static void
+RunQueuePush(tSmeSchedWorker *pWorker, tSmeInstance inst)
+{
+	ptSmeSched pSched = pWorker->pSched;
+	uint32_t capacity = pSched->pPool->capacity;
+
+	pthread_mutex_lock(&pWorker->lock);
+	pWorker->pRing[(pWorker->head + pWorker->count) % capacity] = inst;
+	++pWorker->count;
+	pthread_mutex_unlock(&pWorker->lock);
+
+	(void)atomic_fetch_add(&pSched->queued, 1);
+	if(atomic_load(&pSched->sleepers))
+	{
+		pthread_mutex_lock(&pSched->parklock);
+		pthread_cond_signal(&pSched->parkcond);
+		pthread_mutex_unlock(&pSched->parklock);
+	}
+}
+
+/** Take an instance from a run queue: from the head for the owner, from the tail for a thief.
+ *	@returns true if an instance was taken.
+ */
+static bool
+RunQueueTake(tSmeSchedWorker *pWorker, bool steal, tSmeInstance *pinst)
+{
+	bool taken = false;
+	uint32_t capacity = pWorker->pSched->pPool->capacity;
+
+	pthread_mutex_lock(&pWorker->lock);
+	if(pWorker->count)
+	{
+		if(steal)
+		{
+			*pinst = pWorker->pRing[(pWorker->head + pWorker->count - 1) % capacity];
+		}
+		else
+		{
+			*pinst = pWorker->pRing[pWorker->head];
+			pWorker->head = (pWorker->head + 1) % capacity;
+		}
+		--pWorker->count;
+		taken = true;
+	}
+	pthread_mutex_unlock(&pWorker->lock);
+
+	if(taken)	{ (void)atomic_fetch_sub(&pWorker->pSched->queued, 1); }
+	return taken;
+}
+
+/** Find work for a worker: its own run queue first, then the other workers' run queues. */
+static bool
+FindWork(tSmeSchedWorker *pWorker, tSmeInstance *pinst)
+{
+	ptSmeSched pSched = pWorker->pSched;
+	uint32_t victim;
+
+	if(RunQueueTake(pWorker, false, pinst))	{ return true; }
+	for(victim = 1; victim < pSched->nWorkers; ++victim)
+	{
+		if(RunQueueTake(&pSched->pWorkers[(pWorker->id + victim) % pSched->nWorkers], true, pinst))
+		{
+			(void)atomic_fetch_add_explicit(&pSched->steals, 1, memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+/** Run up to CWSW_SME_SCHED_BUDGET events of one instance. */
+static void
+RunInstance(tSmeSchedWorker *pWorker, tSmeInstance inst)
+{
+	ptSmeSched pSched = pWorker->pSched;
+	ptSmeMpscEntry pEntry;
+	uint32_t budget = atomic_load(&pSched->pPending[inst]);
+	uint32_t ran = 0;
+
+	/* this worker is the inbox's only consumer while the instance is scheduled. it runs no more
+	 * events than have been counted, so that the count never drops below what is still to run.
+	 */
+	if(budget > CWSW_SME_SCHED_BUDGET)	{ budget = CWSW_SME_SCHED_BUDGET; }
+	while((ran < budget) && ((pEntry = Cwsw_Sme_Mpsc_Peek(pSched->pInbox, inst)) != NULL))
+	{
+		(void)Cwsw_Sme__SMEInst(pSched->pPool, inst, pEntry->ev, pEntry->extra);
+		Cwsw_Sme_Mpsc_Release(pSched->pInbox, inst);
+		++ran;
+		(void)atomic_fetch_add_explicit(&pSched->events, 1, memory_order_relaxed);
+		if(atomic_fetch_sub(&pSched->outstanding, 1) == 1)
+		{
+			pthread_mutex_lock(&pSched->parklock);
+			pthread_cond_broadcast(&pSched->drainedcond);
+			pthread_mutex_unlock(&pSched->parklock);
+		}
+	}
+
+	if((atomic_fetch_sub(&pSched->pPending[inst], ran) - ran) != 0)
+	{
+		/* still scheduled: more events came in, or the budget ran out. if none could run, the head of
+		 * the inbox is a slot still being filled by a poster that has not got as far as counting it.
+		 */
+		if(!ran)	{ (void)sched_yield(); }
+		RunQueuePush(pWorker, inst);
+	}
+}
+
+static void *
+WorkerMain(void *arg)
+{
+	tSmeSchedWorker *pWorker = (tSmeSchedWorker *)arg;
+	ptSmeSched pSched = pWorker->pSched;
+	tSmeInstance inst;
+
+	while(atomic_load(&pSched->running))
+	{
+		if(FindWork(pWorker, &inst))
+		{
+			(void)atomic_fetch_add_explicit(&pSched->runs, 1, memory_order_relaxed);
+			RunInstance(pWorker, inst);
+			continue;
+		}
+
+		pthread_mutex_lock(&pSched->parklock);
+		(void)atomic_fetch_add(&pSched->sleepers, 1);
+		while(atomic_load(&pSched->running) && !atomic_load(&pSched->queued))
+		{
+			pthread_cond_wait(&pSched->parkcond, &pSched->parklock);
+		}
+		(void)atomic_fetch_sub(&pSched->sleepers, 1);
+		pthread_mutex_unlock(&pSched->parklock);
+	}
+	return NULL;
+}
+
+/** Stop and join the first `nthreads` worker threads. */
+static void
+StopWorkers(ptSmeSched pSched, uint32_t nthreads)
+{
+	uint32_t idx;
+
+	pthread_mutex_lock(&pSched->parklock);
+	atomic_store(&pSched->running, false);
+	pthread_cond_broadcast(&pSched->parkcond);
+	pthread_mutex_unlock(&pSched->parklock);
+
+	for(idx = 0; idx < nthreads; ++idx)
+	{
+		pthread_join(pSched->pWorkers[idx].thread, NULL);
+	}
+}
+
+/** Release everything the scheduler allocated or initialized. Threads must already be stopped.
+ *	Also called when Create fails part way, before the locks and conditions exist.
+ */
+static void
+FreeSched(ptSmeSched pSched)
+{
+	uint32_t idx;
+
+	if(pSched->synced)
+	{
+		for(idx = 0; idx < pSched->nWorkers; ++idx)
+		{
+			pthread_mutex_destroy(&pSched->pWorkers[idx].lock);
+		}
+		pthread_cond_destroy(&pSched->drainedcond);
+		pthread_cond_destroy(&pSched->parkcond);
+		pthread_mutex_destroy(&pSched->parklock);
+	}
+	if(pSched->pWorkers)
+	{
+		for(idx = 0; idx < pSched->nWorkers; ++idx)
+		{
+			free(pSched->pWorkers[idx].pRing);
+		}
+	}
+	free(pSched->pWorkers);
+	Cwsw_Sme_Mpsc_Destroy(pSched->pInbox);
+	free((void *)pSched->pPending);
+	free(pSched);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/** Create a scheduler for a pool, and start its worker threads.
+ *	Instance `inst` has worker `inst % nWorkers` as its home; idle workers steal from busy ones.
+ *
+ *	@param[in]	pPool		Initialized pool. Instances may be added after the scheduler is created,
+ *							but no events may be posted to them until they are. The pool must not
+ *							have a timing wheel: a wheel belongs to one thread, and the workers'
+ *							handlers would arm it from several.
+ *	@param[in]	nWorkers	Number of worker threads; at least 1.
+ *	@param[in]	szInbox		Capacity in events of each instance's inbox; a power of 2.
+ *
+ *	@returns The scheduler, or NULL if the arguments are invalid or resources are not available.
+ */
+ptSmeSched
+Cwsw_Sme_Sched_Create(ptSmePool pPool, uint32_t nWorkers, uint32_t szInbox)
+{
+	ptSmeSched pSched;
+	uint32_t idx;
+	uint32_t started;
+
+	if(!pPool || !pPool->capacity || !nWorkers)		{ return NULL; }
+	if(pPool->pWheel)								{ return NULL; }
+	if(!szInbox || (szInbox & (szInbox - 1)))		{ return NULL; }
+
+	pSched = (ptSmeSched)calloc(1, sizeof(*pSched));
+	if(!pSched)										{ return NULL; }
+
+	pSched->pPool		= pPool;
+	pSched->nWorkers	= nWorkers;
+	pSched->pWorkers	= (tSmeSchedWorker *)calloc(nWorkers, sizeof(*pSched->pWorkers));
+	pSched->pInbox		= Cwsw_Sme_Mpsc_Create(pPool, szInbox);
+	pSched->pPending	= (atomic_uint *)calloc(pPool->capacity, sizeof(*pSched->pPending));
+	if(!pSched->pWorkers || !pSched->pInbox || !pSched->pPending)
+	{
+		FreeSched(pSched);
+		return NULL;
+	}
+	for(idx = 0; idx < nWorkers; ++idx)
+	{
+		pSched->pWorkers[idx].pRing = (tSmeInstance *)calloc(pPool->capacity, sizeof(tSmeInstance));
+		if(!pSched->pWorkers[idx].pRing)
+		{
+			FreeSched(pSched);
+			return NULL;
+		}
+	}
+
+	pthread_mutex_init(&pSched->parklock, NULL);
+	pthread_cond_init(&pSched->parkcond, NULL);
+	pthread_cond_init(&pSched->drainedcond, NULL);
+	atomic_init(&pSched->running, true);
+
+	for(idx = 0; idx < nWorkers; ++idx)
+	{
+		pSched->pWorkers[idx].pSched = pSched;
+		pSched->pWorkers[idx].id = idx;
+		pthread_mutex_init(&pSched->pWorkers[idx].lock, NULL);
+	}
+	pSched->synced = true;
+	for(started = 0; started < nWorkers; ++started)
+	{
+		if(pthread_create(&pSched->pWorkers[started].thread, NULL, WorkerMain, &pSched->pWorkers[started]))
+		{
+			break;
+		}
+	}
+	if(started < nWorkers)
+	{
+		StopWorkers(pSched, started);
+		FreeSched(pSched);
+		return NULL;
+	}
+	return pSched;
+}
+
+/** Post an event to one instance.
+ *	May be called from any thread, including from within a state handler run by the scheduler.
+ *	Events posted to the same instance by one thread run in the order posted.
+ *
+ *	@returns true if the event was queued; false if the instance is not allocated, or its inbox is
+ *	full.
+ */
+bool
+Cwsw_Sme_Sched_Post(ptSmeSched pSched, tSmeInstance inst, tEvQ_Event ev, uint32_t extra)
+{
+	if(!pSched || (inst >= pSched->pPool->count))	{ return false; }
+
+	// count the event before it's visible, so that a drain cannot finish while it's pending.
+	(void)atomic_fetch_add(&pSched->outstanding, 1);
+
+	if(!Cwsw_Sme_Mpsc_Post(pSched->pInbox, inst, ev, extra))
+	{
+		(void)atomic_fetch_sub(&pSched->outstanding, 1);
+		(void)atomic_fetch_add_explicit(&pSched->rejected, 1, memory_order_relaxed);
+		return false;
+	}
+
+	// counted only once committed; the first pending event schedules the instance.
+	if(atomic_fetch_add(&pSched->pPending[inst], 1) == 0)
+	{
+		RunQueuePush(&pSched->pWorkers[inst % pSched->nWorkers], inst);
+	}
+	return true;
+}
+
+/** Wait until every event posted so far has been run. */
+void
+Cwsw_Sme_Sched_Drain(ptSmeSched pSched)
+{
+	if(!pSched)	{ return; }
+
+	pthread_mutex_lock(&pSched->parklock);
+	while(atomic_load(&pSched->outstanding))
+	{
+		pthread_cond_wait(&pSched->drainedcond, &pSched->parklock);
+	}
+	pthread_mutex_unlock(&pSched->parklock);
+}
+
+/** Report the scheduler's counters. */
+void
+Cwsw_Sme_Sched_Stats(ptSmeSched pSched, ptSmeSchedStats pStats)
+{
+	if(!pSched || !pStats)	{ return; }
+
+	pStats->events	 = atomic_load_explicit(&pSched->events, memory_order_relaxed);
+	pStats->runs	 = atomic_load_explicit(&pSched->runs, memory_order_relaxed);
+	pStats->steals	 = atomic_load_explicit(&pSched->steals, memory_order_relaxed);
+	pStats->rejected = atomic_load_explicit(&pSched->rejected, memory_order_relaxed);
+}
+
+/** Stop the worker threads and release the scheduler.
+ *	Events still pending are discarded; call Cwsw_Sme_Sched_Drain() first to run them.
+ */
+void
+Cwsw_Sme_Sched_Destroy(ptSmeSched pSched)
+{
+	if(!pSched)	{ return; }
+
+	StopWorkers(pSched, pSched->nWorkers);
+	FreeSched(pSched);
+}
@@ -0,0 +1,295 @@
+/** @file
+ *	@brief	Snapshot and restore of a pool of SME instances, for warm restart.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <string.h>		/* memcpy() */
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme_snapshot.h"
+#include "cwsw_sme_wheel.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+#define FNV32_OFFSET	(2166136261u)
+#define FNV32_PRIME		(16777619u)
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+static uint32_t
+Checksum(uint8_t const *pData, size_t len)
+{
+	uint32_t hash = FNV32_OFFSET;
+	size_t idx;
+
+	for(idx = 0; idx < len; ++idx)
+	{
+		hash = (hash ^ pData[idx]) * FNV32_PRIME;
+	}
+	return hash;
+}
+
+/** Bytes of an image of `count` instances, after the header. */
+static size_t
+PayloadSize(uint32_t count, uint32_t szUser, bool wheel)
+{
+	size_t perinst = sizeof(int32_t) + sizeof(uint32_t) + sizeof(uint16_t) + sizeof(uint8_t);
+
+	if(wheel)	{ perinst += sizeof(int32_t) + sizeof(uint32_t); }
+	return ((size_t)count * perinst) + ((size_t)count * szUser);
+}
+
+static int32_t
+TicsUntil(tCwswClockTics deadline, tCwswClockTics now)
+{
+	return (int32_t)((uint32_t)deadline - (uint32_t)now);
+}
+
+/* the columns are written and read one element at a time through memcpy(), so the image needs
+ * no particular alignment; compilers reduce each copy to a plain load or store.
+ */
+static uint8_t *
+Put32(uint8_t *pDst, uint32_t value)
+{
+	memcpy(pDst, &value, sizeof(value));
+	return pDst + sizeof(value);
+}
+
+static uint8_t const *
+Get32(uint8_t const *pSrc, uint32_t *pvalue)
+{
+	memcpy(pvalue, pSrc, sizeof(*pvalue));
+	return pSrc + sizeof(*pvalue);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/** Size in bytes of the image of a pool, as it is now. */
+size_t
+Cwsw_Sme_Snapshot_Size(ptSmePool pPool)
+{
+	if(!pPool)	{ return 0; }
+	return sizeof(tSmeSnapshotHeader) + PayloadSize(pPool->count, pPool->szUser, (pPool->pWheel != NULL));
+}
+
+/** Write the image of a pool.
+ *	The pool must not be stepped while it is saved.
+ *
+ *	@returns The size in bytes of the image; 0 if the storage is too small, or an instance is in a
+ *	state that isn't in the state list.
+ */
+size_t
+Cwsw_Sme_Snapshot_Save(
+	ptSmePool				pPool,
+	pfStateHandler const	*pStates,
+	uint32_t				nStates,
+	tCwswClockTics			now,
+	void					*pImage,
+	size_t					szImage)
+{
+	tSmeSnapshotHeader hdr;
+	uint8_t *pOut = (uint8_t *)pImage;
+	uint8_t *pPayload;
+	ptSmeWheel pWheel;
+	uint32_t inst;
+	uint32_t state = 0;
+	uint16_t idx16;
+	size_t size;
+
+	if(!pPool || !pStates || !pImage)			{ return 0; }
+	if(!nStates || (nStates > UINT16_MAX))		{ return 0; }
+	size = Cwsw_Sme_Snapshot_Size(pPool);
+	if(szImage < size)							{ return 0; }
+
+	pWheel = pPool->pWheel;
+	pPayload = pOut + sizeof(hdr);
+	pOut = pPayload;
+
+	for(inst = 0; inst < pPool->count; ++inst)
+	{
+		pOut = Put32(pOut, (uint32_t)TicsUntil(pPool->pTimer[inst], now));
+	}
+	for(inst = 0; inst < pPool->count; ++inst)
+	{
+		pOut = Put32(pOut, (uint32_t)pPool->pEvId[inst]);
+	}
+	if(pWheel)
+	{
+		for(inst = 0; inst < pPool->count; ++inst)
+		{
+			int32_t left = 0;
+			if(Cwsw_Sme_Wheel_IsArmed(pWheel, inst))
+			{
+				// a timeout already due still has to be delivered; keep it at least 1 tic away.
+				left = TicsUntil(pWheel->pDeadline[inst], now);
+				if(left < 1)	{ left = 1; }
+			}
+			pOut = Put32(pOut, (uint32_t)left);
+		}
+		for(inst = 0; inst < pPool->count; ++inst)
+		{
+			pOut = Put32(pOut, (uint32_t)pWheel->pEvId[inst]);
+		}
+	}
+	for(inst = 0; inst < pPool->count; ++inst)
+	{
+		// neighbouring instances are often in the same state; try the last one found first.
+		if(pStates[state] != pPool->pState[inst])
+		{
+			for(state = 0; (state < nStates) && (pStates[state] != pPool->pState[inst]); ++state)	{ }
+			if(state == nStates)	{ return 0; }
+		}
+		idx16 = (uint16_t)state;
+		memcpy(pOut, &idx16, sizeof(idx16));
+		pOut += sizeof(idx16);
+	}
+	for(inst = 0; inst < pPool->count; ++inst)
+	{
+		*pOut++ = (uint8_t)pPool->pPhase[inst];
+	}
+	if(pPool->szUser && pPool->count)
+	{
+		memcpy(pOut, pPool->pUser, (size_t)pPool->count * pPool->szUser);
+		pOut += (size_t)pPool->count * pPool->szUser;
+	}
+
+	hdr.magic		= SME_SNAPSHOT_MAGIC;
+	hdr.version		= SME_SNAPSHOT_VERSION;
+	hdr.flags		= pWheel ? kSmeSnapshot_Wheel : 0;
+	hdr.count		= pPool->count;
+	hdr.nStates		= nStates;
+	hdr.szUser		= pPool->szUser;
+	hdr.checksum	= Checksum(pPayload, (size_t)(pOut - pPayload));
+	memcpy(pImage, &hdr, sizeof(hdr));
+	return size;
+}
+
+/** Restore a pool from its image.
+ *	The image is checked completely before the pool is touched: on failure, the pool is unchanged.
+ *	On success, the pool holds exactly the instances in the image, with the same handles, and the
+ *	pool's timing wheel, if any, is re-initialized at `now` with the saved timeouts re-armed.
+ *
+ *	@returns true if the pool was restored; false if the image is invalid, was written with a
+ *	different state list or application-data size, holds more instances than the pool can, or
+ *	holds timeouts and the pool has no wheel.
+ */
+bool
+Cwsw_Sme_Snapshot_Restore(
+	ptSmePool				pPool,
+	pfStateHandler const	*pStates,
+	uint32_t				nStates,
+	tCwswClockTics			now,
+	void const				*pImage,
+	size_t					szImage)
+{
+	tSmeSnapshotHeader hdr;
+	uint8_t const *pIn = (uint8_t const *)pImage;
+	uint8_t const *pPayload;
+	uint8_t const *pStateCol;
+	uint8_t const *pPhaseCol;
+	ptSmeWheel pWheel;
+	bool wheel;
+	uint32_t inst;
+	uint32_t value;
+	uint16_t idx16;
+	size_t payload;
+
+	if(!pPool || !pStates || !pImage)					{ return false; }
+	if(szImage < sizeof(hdr))							{ return false; }
+
+	memcpy(&hdr, pImage, sizeof(hdr));
+	if(hdr.magic != SME_SNAPSHOT_MAGIC)					{ return false; }
+	if(hdr.version != SME_SNAPSHOT_VERSION)				{ return false; }
+	if(hdr.nStates != nStates)							{ return false; }
+	if(hdr.szUser != pPool->szUser)						{ return false; }
+	if(hdr.count > pPool->capacity)						{ return false; }
+
+	wheel = ((hdr.flags & kSmeSnapshot_Wheel) != 0);
+	pWheel = pPool->pWheel;
+	if(wheel && !pWheel)								{ return false; }
+
+	payload = PayloadSize(hdr.count, hdr.szUser, wheel);
+	if(szImage < (sizeof(hdr) + payload))				{ return false; }
+	pPayload = pIn + sizeof(hdr);
+	if(Checksum(pPayload, payload) != hdr.checksum)		{ return false; }
+
+	// validate the state and phase columns before anything is written.
+	pStateCol = pPayload + ((size_t)hdr.count * (wheel ? 4u : 2u) * sizeof(uint32_t));
+	pPhaseCol = pStateCol + ((size_t)hdr.count * sizeof(uint16_t));
+	for(inst = 0; inst < hdr.count; ++inst)
+	{
+		memcpy(&idx16, pStateCol + (inst * sizeof(idx16)), sizeof(idx16));
+		if(idx16 >= nStates)						{ return false; }
+		if(pPhaseCol[inst] > kStateFinished)		{ return false; }
+	}
+
+	pIn = pPayload;
+	pPool->count = hdr.count;
+	for(inst = 0; inst < hdr.count; ++inst)
+	{
+		pIn = Get32(pIn, &value);
+		pPool->pTimer[inst] = (tCwswClockTics)((uint32_t)now + value);
+	}
+	for(inst = 0; inst < hdr.count; ++inst)
+	{
+		pIn = Get32(pIn, &value);
+		pPool->pEvId[inst] = (tEvQ_EventID)value;
+	}
+	if(pWheel)
+	{
+		(void)Cwsw_Sme_Wheel_Init(pWheel, now);
+	}
+	if(wheel)
+	{
+		uint8_t const *pEvIdCol = pIn + ((size_t)hdr.count * sizeof(uint32_t));
+		for(inst = 0; inst < hdr.count; ++inst)
+		{
+			uint32_t evid;
+			pIn = Get32(pIn, &value);
+			(void)Get32(pEvIdCol + (inst * sizeof(uint32_t)), &evid);
+			if(value)	{ Cwsw_Sme_Wheel_Arm(pWheel, inst, (tCwswClockTics)value, (tEvQ_EventID)evid); }
+		}
+		pIn = pEvIdCol + ((size_t)hdr.count * sizeof(uint32_t));
+	}
+	for(inst = 0; inst < hdr.count; ++inst)
+	{
+		memcpy(&idx16, pIn, sizeof(idx16));
+		pIn += sizeof(idx16);
+		pPool->pState[inst] = pStates[idx16];
+	}
+	for(inst = 0; inst < hdr.count; ++inst)
+	{
+		pPool->pPhase[inst] = (tStateReturnCodes)*pIn++;
+	}
+	if(hdr.szUser && hdr.count)
+	{
+		memcpy(pPool->pUser, pIn, (size_t)hdr.count * hdr.szUser);
+	}
+	// dwell times are statistics, not state; they restart with the restore.
+	for(inst = 0; pPool->pEntered && (inst < hdr.count); ++inst)
+	{
+		pPool->pEntered[inst] = now;
+	}
+	return true;
+}
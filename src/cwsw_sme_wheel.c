@@ -0,0 +1,387 @@
+/** @file
+ *	@brief	Timeout service for pools of SME instances, built on a hashed timing wheel.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme_wheel.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/** Marks, in pPrev, a timeout that is not armed. */
+#define kUnarmed	((tSmeInstance)0xFFFFFFFEu)
+
+/** Marks, in pPrev, a timeout that has expired and waits on the `expiring` list for delivery. */
+#define kExpiring	((tSmeInstance)0xFFFFFFFDu)
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+#if !defined(CWSW_SME_ALARM_ARM)
+/* default adapter to the software-alarm component; see CWSW_SME_ALARM_ARM() in the header for the
+ * assumptions it makes about the alarm manager. this is the only code that writes a tCwswSwAlarm.
+ */
+static void
+AlarmArm(ptCwswSwAlarm pAlarm, tCwswClockTics delay)
+{
+	pAlarm->tm			= delay;
+	pAlarm->reloadtm	= 0;
+	pAlarm->tmrstate	= kTmrState_Enabled;
+}
+
+static void
+AlarmDisarm(ptCwswSwAlarm pAlarm)
+{
+	pAlarm->tmrstate	= kTmrState_Disabled;
+}
+
+#define CWSW_SME_ALARM_ARM(pAlarm, delay)	AlarmArm(pAlarm, delay)
+#define CWSW_SME_ALARM_DISARM(pAlarm)		AlarmDisarm(pAlarm)
+#endif
+
+/** Signed distance from `now` to `deadline`; safe across wraparound of the clock. */
+static int32_t
+TicsUntil(tCwswClockTics deadline, tCwswClockTics now)
+{
+	return (int32_t)((uint32_t)deadline - (uint32_t)now);
+}
+
+static uint32_t
+SlotOf(ptSmeWheel pWheel, tCwswClockTics deadline)
+{
+	return (uint32_t)deadline & (pWheel->nSlots - 1);
+}
+
+/** Take a timeout out of its slot's list. */
+static void
+Detach(ptSmeWheel pWheel, tSmeInstance inst)
+{
+	tSmeInstance next = pWheel->pNext[inst];
+	tSmeInstance prev = pWheel->pPrev[inst];
+
+	if(prev == kSmeInstanceNone)	{ pWheel->pSlots[SlotOf(pWheel, pWheel->pDeadline[inst])] = next; }
+	else							{ pWheel->pNext[prev] = next; }
+	if(next != kSmeInstanceNone)	{ pWheel->pPrev[next] = prev; }
+}
+
+/** Disarm an armed timeout, whether in its slot or waiting for delivery. */
+static void
+Unlink(ptSmeWheel pWheel, tSmeInstance inst)
+{
+	tSmeInstance *pLink;
+
+	if(pWheel->pPrev[inst] != kExpiring)
+	{
+		Detach(pWheel, inst);
+	}
+	else
+	{
+		// the list is singly linked, and short: the timeouts of the slot being delivered.
+		for(pLink = &pWheel->expiring; *pLink != inst; pLink = &pWheel->pNext[*pLink])	{ }
+		*pLink = pWheel->pNext[inst];
+	}
+
+	pWheel->pNext[inst] = kSmeInstanceNone;
+	pWheel->pPrev[inst] = kUnarmed;
+	--pWheel->nArmed;
+}
+
+/** Expire the due timeouts of one slot.
+ *	The slot is walked once, and its due timeouts moved, in order, to the `expiring` list; they are
+ *	then delivered from there. Delivery runs state handlers, which may arm or cancel any timeout: one
+ *	still waiting on the list is taken off it, as it would have been taken out of its slot.
+ *
+ *	@returns The number of timeouts expired.
+ */
+static uint32_t
+ExpireSlot(ptSmeWheel pWheel, uint32_t slot, tCwswClockTics upto)
+{
+	uint32_t expired = 0;
+	tSmeInstance first = kSmeInstanceNone;
+	tSmeInstance last = kSmeInstanceNone;
+	tSmeInstance inst;
+	tSmeInstance next;
+	tEvQ_Event ev;
+
+	for(inst = pWheel->pSlots[slot]; inst != kSmeInstanceNone; inst = next)
+	{
+		next = pWheel->pNext[inst];
+		if(TicsUntil(pWheel->pDeadline[inst], upto) > 0)	{ continue; }
+
+		Detach(pWheel, inst);
+		pWheel->pPrev[inst] = kExpiring;
+		if(last == kSmeInstanceNone)	{ first = inst; }
+		else							{ pWheel->pNext[last] = inst; }
+		last = inst;
+	}
+	if(last == kSmeInstanceNone)	{ return 0; }
+
+	// ahead of any left by an outer delivery, should a handler have advanced the wheel itself.
+	pWheel->pNext[last] = pWheel->expiring;
+	pWheel->expiring = first;
+
+	while(pWheel->expiring != kSmeInstanceNone)
+	{
+		inst = pWheel->expiring;
+		Unlink(pWheel, inst);
+		ev.evId   = pWheel->pEvId[inst];
+		ev.evData = 0;
+		if(pWheel->pfExpiry)	{ (void)pWheel->pfExpiry(pWheel->pPool, inst, ev, 0); }
+		else					{ (void)Cwsw_Sme__SMEInst(pWheel->pPool, inst, ev, 0); }
+		++expired;
+	}
+	return expired;
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/** Initialize a timing wheel.
+ *	The caller fills in the pool, the optional delivery function, the slot count, and the arrays;
+ *	this disarms every timeout.
+ *
+ *	@param[in,out]	pWheel	Wheel to initialize.
+ *	@param[in]		now		Current time; the wheel starts here.
+ *
+ *	@returns true if the wheel is usable, false if a required field is missing.
+ */
+bool
+Cwsw_Sme_Wheel_Init(ptSmeWheel pWheel, tCwswClockTics now)
+{
+	uint32_t idx;
+
+	if(!pWheel || !pWheel->pPool)											{ return false; }
+	if(!pWheel->nSlots || (pWheel->nSlots & (pWheel->nSlots - 1)))			{ return false; }
+	if(!pWheel->pSlots || !pWheel->pNext || !pWheel->pPrev)					{ return false; }
+	if(!pWheel->pDeadline || !pWheel->pEvId)								{ return false; }
+
+	for(idx = 0; idx < pWheel->nSlots; ++idx)
+	{
+		pWheel->pSlots[idx] = kSmeInstanceNone;
+	}
+	for(idx = 0; idx < pWheel->pPool->capacity; ++idx)
+	{
+		pWheel->pNext[idx] = kSmeInstanceNone;
+		pWheel->pPrev[idx] = kUnarmed;
+		pWheel->pDeadline[idx] = 0;
+		pWheel->pEvId[idx] = 0;
+	}
+	pWheel->now = now;
+	pWheel->nArmed = 0;
+	pWheel->expiring = kSmeInstanceNone;
+	return true;
+}
+
+/** Arm an instance's timeout, replacing any timeout already armed.
+ *	@param[in]	pWheel	Wheel.
+ *	@param[in]	inst	Instance that owns the timeout.
+ *	@param[in]	delay	Time from now until expiry, in clock tics; at least 1.
+ *	@param[in]	evId	Event posted to the instance upon expiry.
+ */
+void
+Cwsw_Sme_Wheel_Arm(ptSmeWheel pWheel, tSmeInstance inst, tCwswClockTics delay, tEvQ_EventID evId)
+{
+	uint32_t slot;
+
+	if(!pWheel || (inst >= pWheel->pPool->capacity))	{ return; }
+
+	if(pWheel->pPrev[inst] != kUnarmed)	{ Unlink(pWheel, inst); }
+	if(delay < 1)						{ delay = 1; }
+
+	pWheel->pDeadline[inst] = (tCwswClockTics)((uint32_t)pWheel->now + (uint32_t)delay);
+	pWheel->pEvId[inst] = evId;
+
+	slot = SlotOf(pWheel, pWheel->pDeadline[inst]);
+	pWheel->pNext[inst] = pWheel->pSlots[slot];
+	pWheel->pPrev[inst] = kSmeInstanceNone;
+	if(pWheel->pSlots[slot] != kSmeInstanceNone)	{ pWheel->pPrev[pWheel->pSlots[slot]] = inst; }
+	pWheel->pSlots[slot] = inst;
+	++pWheel->nArmed;
+}
+
+/** Cancel an instance's timeout, if armed. */
+void
+Cwsw_Sme_Wheel_Cancel(ptSmeWheel pWheel, tSmeInstance inst)
+{
+	if(!pWheel || (inst >= pWheel->pPool->capacity))	{ return; }
+	if(pWheel->pPrev[inst] != kUnarmed)					{ Unlink(pWheel, inst); }
+}
+
+bool
+Cwsw_Sme_Wheel_IsArmed(ptSmeWheel pWheel, tSmeInstance inst)
+{
+	if(!pWheel || (inst >= pWheel->pPool->capacity))	{ return false; }
+	return (pWheel->pPrev[inst] != kUnarmed);
+}
+
+/** Time left before an instance's timeout expires.
+ *	@returns The time left, in clock tics; 0 if the timeout is not armed.
+ */
+tCwswClockTics
+Cwsw_Sme_Wheel_TimeLeft(ptSmeWheel pWheel, tSmeInstance inst)
+{
+	if(!Cwsw_Sme_Wheel_IsArmed(pWheel, inst))	{ return 0; }
+	return (tCwswClockTics)TicsUntil(pWheel->pDeadline[inst], pWheel->now);
+}
+
+/** Advance the wheel to the current time, and deliver the timeouts that have expired.
+ *	Normally called from the task that owns the pool, whenever the clock has moved. Timeouts are
+ *	delivered in the order of their slots; over an advance of less than one revolution, that is
+ *	the order of their deadlines.
+ *
+ *	@returns The number of timeouts delivered.
+ */
+uint32_t
+Cwsw_Sme_Wheel_Advance(ptSmeWheel pWheel, tCwswClockTics now)
+{
+	uint32_t expired = 0;
+	int32_t steps;
+	tCwswClockTics tic;
+
+	if(!pWheel)	{ return 0; }
+
+	steps = TicsUntil(now, pWheel->now);
+	if(steps <= 0)	{ return 0; }
+
+	// past one revolution, every slot has been visited; later-round deadlines are caught by `now`.
+	if((uint32_t)steps > pWheel->nSlots)	{ steps = (int32_t)pWheel->nSlots; }
+
+	tic = pWheel->now;
+	pWheel->now = now;
+	while(steps-- && pWheel->nArmed)
+	{
+		tic = (tCwswClockTics)((uint32_t)tic + 1);
+		expired += ExpireSlot(pWheel, SlotOf(pWheel, tic), now);
+	}
+	return expired;
+}
+
+/** Find the earliest deadline pending on the wheel.
+ *	The slots are searched forward from the current time; the search stops at the first slot
+ *	holding a deadline within the current revolution, so its cost is proportional to the distance
+ *	to that deadline, and at most one revolution.
+ *
+ *	@returns true if a timeout is armed; *pDeadline then holds the earliest deadline.
+ */
+bool
+Cwsw_Sme_Wheel_NextDeadline(ptSmeWheel pWheel, tCwswClockTics *pDeadline)
+{
+	uint32_t step;
+	tSmeInstance inst;
+	bool found = false;
+	tCwswClockTics earliest = 0;
+	tCwswClockTics tic;
+
+	if(!pWheel || !pDeadline || !pWheel->nArmed)	{ return false; }
+
+	tic = pWheel->now;
+	for(step = 1; step <= pWheel->nSlots; ++step)
+	{
+		tic = (tCwswClockTics)((uint32_t)tic + 1);
+		for(inst = pWheel->pSlots[SlotOf(pWheel, tic)]; inst != kSmeInstanceNone; inst = pWheel->pNext[inst])
+		{
+			if(!found || (TicsUntil(pWheel->pDeadline[inst], earliest) < 0))
+			{
+				earliest = pWheel->pDeadline[inst];
+				found = true;
+			}
+		}
+		// a deadline in this revolution, in the nearest occupied slot, is the earliest of all.
+		if(found && (TicsUntil(earliest, pWheel->now) <= (int32_t)step))	{ break; }
+	}
+
+	*pDeadline = earliest;
+	return found;
+}
+
+
+/** Service a tickless SME: deliver expired timeouts, then re-arm the driving alarm.
+ *	Call this from the SME's task, each time the driving alarm matures, with the current time.
+ *
+ *	@returns The number of timeouts delivered.
+ */
+uint32_t
+Cwsw_Sme_Tickless_Service(ptSmeTickless pDrv, tCwswClockTics now)
+{
+	uint32_t expired;
+
+	if(!pDrv || !pDrv->pWheel)	{ return 0; }
+
+	pDrv->armed = false;
+	expired = Cwsw_Sme_Wheel_Advance(pDrv->pWheel, now);
+	Cwsw_Sme_Tickless_Rearm(pDrv);
+	return expired;
+}
+
+/** Re-arm the driving alarm for the earliest pending deadline.
+ *	Call this after arming or cancelling timeouts outside of the SME's task. If nothing is pending,
+ *	the alarm is armed for `maxsleep`, or disabled if that is 0.
+ */
+void
+Cwsw_Sme_Tickless_Rearm(ptSmeTickless pDrv)
+{
+	tCwswClockTics deadline;
+	tCwswClockTics delay;
+
+	if(!pDrv || !pDrv->pAlarm || !pDrv->pWheel)	{ return; }
+
+	if(!Cwsw_Sme_Wheel_NextDeadline(pDrv->pWheel, &deadline))
+	{
+		if(pDrv->maxsleep > 0)
+		{
+			pDrv->deadline = (tCwswClockTics)((uint32_t)pDrv->pWheel->now + (uint32_t)pDrv->maxsleep);
+			pDrv->armed = true;
+			CWSW_SME_ALARM_ARM(pDrv->pAlarm, pDrv->maxsleep);
+		}
+		else
+		{
+			pDrv->armed = false;
+			CWSW_SME_ALARM_DISARM(pDrv->pAlarm);
+		}
+		return;
+	}
+
+	delay = (tCwswClockTics)TicsUntil(deadline, pDrv->pWheel->now);
+	if(delay < 1)										{ delay = 1; }
+	if((pDrv->maxsleep > 0) && (delay > pDrv->maxsleep))	{ delay = pDrv->maxsleep; }
+
+	pDrv->deadline = (tCwswClockTics)((uint32_t)pDrv->pWheel->now + (uint32_t)delay);
+	pDrv->armed = true;
+	++pDrv->rearms;
+	CWSW_SME_ALARM_ARM(pDrv->pAlarm, delay);
+}
+
+/** Wake the SME at once, because an event was posted for it.
+ *	Call this from whatever posts an event to the SME's queue. The driving alarm matures on the
+ *	next pass of the alarm manager; the SME's task re-arms it for the next deadline.
+ */
+void
+Cwsw_Sme_Tickless_Kick(ptSmeTickless pDrv)
+{
+	if(!pDrv || !pDrv->pAlarm)	{ return; }
+
+	++pDrv->kicks;
+	pDrv->armed = true;
+	if(pDrv->pWheel)	{ pDrv->deadline = pDrv->pWheel->now; }
+	CWSW_SME_ALARM_ARM(pDrv->pAlarm, 0);
+}
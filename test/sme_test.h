@@ -0,0 +1,63 @@
+/** @file
+ *	@brief	Minimal checking support for the SME's host tests.
+ *
+ *	Each test program is a plain `main()` that runs its checks and returns TEST_RESULT(); ctest
+ *	treats a nonzero exit status as failure. A failed check reports its file, line and expression,
+ *	and the program carries on, so one run shows every failure.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef SME_TEST_H
+#define SME_TEST_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdio.h>
+
+
+// ============================================================================
+// ----	Constants and Type Definitions ----------------------------------------
+// ============================================================================
+
+static int sme_test_failures = 0;
+
+/** Check a condition; report it if false. */
+#define CHECK(cond)		do { \
+		if(!(cond)) \
+		{ \
+			fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+			++sme_test_failures; \
+		} \
+	} while(0)
+
+/** Check that two integer values are equal; report both if not. */
+#define CHECK_EQ(a, b)	do { \
+		long long const sme_test_a = (long long)(a); \
+		long long const sme_test_b = (long long)(b); \
+		if(sme_test_a != sme_test_b) \
+		{ \
+			fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", \
+				__FILE__, __LINE__, #a, #b, sme_test_a, sme_test_b); \
+			++sme_test_failures; \
+		} \
+	} while(0)
+
+/** Run one test function, naming it on failure. */
+#define RUN_TEST(fn)	do { \
+		int const sme_test_before = sme_test_failures; \
+		fn(); \
+		if(sme_test_failures != sme_test_before)	{ fprintf(stderr, "FAILED: %s\n", #fn); } \
+	} while(0)
+
+/** Exit status of the test program. */
+#define TEST_RESULT()	((sme_test_failures == 0) ? 0 : 1)
+
+#endif /* SME_TEST_H */
@@ -0,0 +1,54 @@
+/** @file
+ *	@brief	Host stand-in for the CWSW extended event queue, for building the SME off-target.
+ *
+ *	Supplies only what the SME uses from the event queue: the event, its ID, and the event-handler
+ *	signature used by transition functions. Projects build against the real cwsw_evqueue_ex.h; this
+ *	file is on the include path of the host build (CMakeLists.txt) only.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_EVQUEUE_EX_H
+#define CWSW_EVQUEUE_EX_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants and Type Definitions ----------------------------------------
+// ============================================================================
+
+/** Event identifier. */
+typedef int32_t tEvQ_EventID;
+
+/** Event, as posted to and dispatched from an event queue. */
+typedef struct sEvQ_Event {
+	tEvQ_EventID	evId;		// event identifier
+	uint32_t		evData;		// event data; meaning is specific to the event
+} tEvQ_Event, *ptEvQ_Event;
+
+/** Event handler, as associated with an event ID in an extended event queue. */
+typedef void (*ptEvQ_EvHandlerFunc)(tEvQ_Event ev, uint32_t extra);
+
+/** Extended event queue; opaque to the SME. */
+typedef struct sEvQ_QueueCtrlEx *ptEvQ_QueueCtrlEx;
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_EVQUEUE_EX_H */
@@ -0,0 +1,62 @@
+/** @file
+ *	@brief	Host stand-in for the CWSW software timers, for building the SME off-target.
+ *
+ *	Supplies only what the SME uses from the software timers: the clock tic type and the software
+ *	alarm. The alarm is laid out as the SME's default tickless adapter assumes (see
+ *	CWSW_SME_ALARM_ARM() in cwsw_sme_wheel.h): `tm` counts down, and the alarm matures at 0. There
+ *	is no alarm manager here; host tests inspect the fields instead. Projects build against the real
+ *	cwsw_swtimer.h; this file is on the include path of the host build (CMakeLists.txt) only.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_SWTIMER_H
+#define CWSW_SWTIMER_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_evqueue_ex.h"
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants and Type Definitions ----------------------------------------
+// ============================================================================
+
+/** Clock tics; signed, so that the time left on an expired timer is negative. */
+typedef int32_t tCwswClockTics;
+
+/** State of a software alarm. */
+typedef enum eCwswTmrState {
+	kTmrState_Disabled,		//!< the alarm does not count, and does not mature
+	kTmrState_Enabled		//!< the alarm counts down, and posts its event upon maturation
+} tCwswTmrState;
+
+/** Software alarm: a timer that posts an event upon maturation. */
+typedef struct sCwswSwAlarm {
+	tCwswClockTics		tm;			// time left until maturation
+	tCwswClockTics		reloadtm;	// reload value upon maturation; 0 for a one-shot
+	ptEvQ_QueueCtrlEx	pEvQX;		// event queue that receives the event
+	tEvQ_EventID		evid;		// event posted upon maturation
+	tCwswTmrState		tmrstate;	// enabled or not
+} tCwswSwAlarm, *ptCwswSwAlarm;
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_SWTIMER_H */
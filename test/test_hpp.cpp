@@ -0,0 +1,133 @@
+/** @file
+ *	@brief	Host tests for the compile-time specialized C++ front end.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+
+// ----	Project Headers -------------------------
+#include "sme_test.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme.hpp"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+namespace {
+
+enum { evTick = 1, evGo = 2, evAlarm = 3 };
+enum { kRed = 1, kGreen = 2, kYellow = 3 };
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+int transitions = 0;
+
+/* stateless, so that both engines can drive them side by side: each leaves on evGo or evAlarm,
+ * naming itself in the extra parameter.
+ */
+tStateReturnCodes
+Leave(uint32_t self, ptEvQ_Event pev, uint32_t *pextra)
+{
+	if((pev->evId == evGo) || (pev->evId == evAlarm))
+	{
+		*pextra = self;
+		return kStateFinished;
+	}
+	return kStateOperational;
+}
+
+tStateReturnCodes Red(ptEvQ_Event pev, uint32_t *pextra)		{ return Leave(kRed, pev, pextra); }
+tStateReturnCodes Green(ptEvQ_Event pev, uint32_t *pextra)	{ return Leave(kGreen, pev, pextra); }
+tStateReturnCodes Yellow(ptEvQ_Event pev, uint32_t *pextra)	{ return Leave(kYellow, pev, pextra); }
+tStateReturnCodes Flash(ptEvQ_Event pev, uint32_t *pextra)	{ return Leave(0, pev, pextra); }
+
+void Count(tEvQ_Event, uint32_t)				{ ++transitions; }
+bool Odd(tEvQ_Event ev, uint32_t)				{ return (ev.evData % 2) != 0; }
+
+using States = cwsw::sme::States<Red, Green, Yellow, Flash>;
+using Table = cwsw::sme::Table<
+	cwsw::sme::Row<Red,    evGo,    kRed,    Green>,
+	cwsw::sme::Row<Green,  evGo,    kGreen,  Yellow>,
+	cwsw::sme::Row<Yellow, evGo,    kYellow, Red,   Count>,
+	cwsw::sme::Row<Yellow, evGo,    kYellow, Green, nullptr, 0, Odd>,					// later row wins, when its guard passes
+	cwsw::sme::Row<Red,    evAlarm, 0,       Flash, Count, 0, nullptr, kSmeMatch_Reason1>,
+	cwsw::sme::Row<Green,  0,       0,       Flash, nullptr, 0, nullptr, kSmeMatch_StateOnly>,
+	cwsw::sme::Row<Flash,  evGo,    0,       Red,   Count, 0, nullptr, kSmeMatch_Reason1> >;
+
+
+// ============================================================================
+// ----	Tests -----------------------------------------------------------------
+// ============================================================================
+
+/** The specialized machine steps exactly as the C engine does, over the same table. */
+void
+test_matches_c_engine()
+{
+	cwsw::sme::Machine<States, Table> machine(Red);
+	pfStateHandler state = Red;
+	uint32_t lcg = 1;
+	int mismatches = 0;
+	int cpptransitions = 0;
+
+	CHECK_EQ(Table::size, 7);
+	for(int step = 0; step < 10000; ++step)
+	{
+		lcg = (lcg * 1103515245u) + 12345u;
+		tEvQ_Event ev = { static_cast<tEvQ_EventID>(1 + ((lcg >> 16) % 3)), (lcg >> 20) % 4 };
+
+		transitions = 0;
+		(void)machine.Step(ev, 0);
+		cpptransitions += transitions;
+		transitions = 0;
+		state = Cwsw_Sme__SME(Table::table, Table::size, state, ev, 0);
+		cpptransitions -= transitions;
+		if(machine.State() != state)	{ ++mismatches; }
+	}
+	CHECK_EQ(mismatches, 0);
+	CHECK_EQ(cpptransitions, 0);
+}
+
+void
+test_state_index()
+{
+	cwsw::sme::Machine<States, Table> machine(Yellow);
+
+	CHECK_EQ(machine.StateIndex(), 2);
+	CHECK(machine.Step(tEvQ_Event{ evGo, 1 }, 0) == Green);
+	CHECK_EQ(machine.StateIndex(), 1);
+	CHECK(machine.Step(tEvQ_Event{ evTick, 0 }, 0) == Green);
+	machine.SetState(Flash);
+	CHECK(machine.Step(tEvQ_Event{ evGo, 0 }, 0) == Red);
+	machine.SetState(nullptr);
+	CHECK(machine.State() == nullptr);
+}
+
+} // namespace
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main()
+{
+	RUN_TEST(test_matches_c_engine);
+	RUN_TEST(test_state_index);
+	return TEST_RESULT();
+}
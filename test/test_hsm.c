@@ -0,0 +1,240 @@
+/** @file
+ *	@brief	Host tests for hierarchical state machines, flattened ahead of time.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "sme_test.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum { evGo = 1, evReset = 2, evOther = 3 };
+
+#define TABLE_SIZE(tbl)		((uint32_t)(sizeof(tbl) / sizeof((tbl)[0])))
+
+/** Storage for the flattened table and its action list. */
+#define MAXFLAT				(32)
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+/** Every action taken, in order: `(`/`)` entry/exit of O, `[`/`]` of P, `{`/`}` of Q; `t` for a
+ *	transition function.
+ */
+static char		actionlog[64];
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+static void
+Log(char c)
+{
+	size_t len = strlen(actionlog);
+	if(len + 1 < sizeof(actionlog))
+	{
+		actionlog[len] = c;
+		actionlog[len + 1] = '\0';
+	}
+}
+
+/* every simple state leaves as soon as a row lets it; composites are never called. */
+static tStateReturnCodes Leaf(ptEvQ_Event pev, uint32_t *pextra)	{ (void)pev; (void)pextra; return kStateFinished; }
+static tStateReturnCodes P1(ptEvQ_Event pev, uint32_t *pextra)		{ return Leaf(pev, pextra); }
+static tStateReturnCodes P2(ptEvQ_Event pev, uint32_t *pextra)		{ return Leaf(pev, pextra); }
+static tStateReturnCodes Q1(ptEvQ_Event pev, uint32_t *pextra)		{ return Leaf(pev, pextra); }
+static tStateReturnCodes X(ptEvQ_Event pev, uint32_t *pextra)		{ return Leaf(pev, pextra); }
+static tStateReturnCodes O(ptEvQ_Event pev, uint32_t *pextra)		{ (void)pev; (void)pextra; return kStateUninit; }
+static tStateReturnCodes P(ptEvQ_Event pev, uint32_t *pextra)		{ (void)pev; (void)pextra; return kStateUninit; }
+static tStateReturnCodes Q(ptEvQ_Event pev, uint32_t *pextra)		{ (void)pev; (void)pextra; return kStateUninit; }
+
+static void EnterO(tEvQ_Event ev, uint32_t extra)	{ (void)ev; (void)extra; Log('('); }
+static void ExitO(tEvQ_Event ev, uint32_t extra)	{ (void)ev; (void)extra; Log(')'); }
+static void EnterP(tEvQ_Event ev, uint32_t extra)	{ (void)ev; (void)extra; Log('['); }
+static void ExitP(tEvQ_Event ev, uint32_t extra)	{ (void)ev; (void)extra; Log(']'); }
+static void EnterQ(tEvQ_Event ev, uint32_t extra)	{ (void)ev; (void)extra; Log('{'); }
+static void ExitQ(tEvQ_Event ev, uint32_t extra)	{ (void)ev; (void)extra; Log('}'); }
+static void Trans(tEvQ_Event ev, uint32_t extra)	{ (void)ev; (void)extra; Log('t'); }
+
+/*	X			top level
+ *	O			top level, initial P
+ *		P		initial P1
+ *			P1
+ *			P2
+ *		Q		initial Q1
+ *			Q1
+ */
+static tSmeHsmState const	hierarchy[] = {
+	{ O,  NULL, P,    EnterO, ExitO },
+	{ P,  O,    P1,   EnterP, ExitP },
+	{ Q,  O,    Q1,   EnterQ, ExitQ },
+	{ P1, P,    NULL, NULL,   NULL },
+	{ P2, P,    NULL, NULL,   NULL },
+	{ Q1, Q,    NULL, NULL,   NULL },
+};
+
+static tTransitionTable		tbl[] = {
+	{ O,  evReset, 0, 0, X,  Trans, NULL, kSmeMatch_Reason1 },	// inherited by every state within O
+	{ P1, evGo,    0, 0, P2, Trans, NULL, kSmeMatch_Reason1 },
+	{ P1, evReset, 0, 0, P2, Trans, NULL, kSmeMatch_Reason1 },	// overrides O's row, for P1
+	{ P2, evGo,    0, 0, Q,  Trans, NULL, kSmeMatch_Reason1 },
+	{ Q,  evGo,    0, 0, P2, Trans, NULL, kSmeMatch_Reason1 },
+	{ X,  evGo,    0, 0, O,  Trans, NULL, kSmeMatch_Reason1 },
+};
+
+static tTransitionTable		flat[MAXFLAT];
+static tSmeHsmPath			paths[MAXFLAT];
+static ptEvQ_EvHandlerFunc	actions[MAXFLAT];
+
+
+// ============================================================================
+// ----	Tests -----------------------------------------------------------------
+// ============================================================================
+
+static void
+BuildHsm(ptSmeHsm pHsm)
+{
+	uint32_t szflat = 0;
+	uint32_t nactions = 0;
+
+	CHECK(Cwsw_Sme_Hsm_Size(hierarchy, TABLE_SIZE(hierarchy), tbl, TABLE_SIZE(tbl), &szflat, &nactions));
+	CHECK(szflat <= MAXFLAT);
+	CHECK(nactions <= MAXFLAT);
+	CHECK(Cwsw_Sme_Hsm_Init(pHsm, hierarchy, TABLE_SIZE(hierarchy), tbl, TABLE_SIZE(tbl),
+			flat, paths, MAXFLAT, actions, MAXFLAT));
+	CHECK_EQ(pHsm->szFlat, szflat);
+	CHECK_EQ(pHsm->nActions, nactions);
+}
+
+static void
+test_resolve(void)
+{
+	tSmeHsm hsm;
+
+	BuildHsm(&hsm);
+	CHECK(Cwsw_Sme_Hsm_Resolve(&hsm, O) == P1);
+	CHECK(Cwsw_Sme_Hsm_Resolve(&hsm, Q) == Q1);
+	CHECK(Cwsw_Sme_Hsm_Resolve(&hsm, P2) == P2);
+	CHECK(Cwsw_Sme_Hsm_Resolve(&hsm, X) == X);
+}
+
+/** Each transition exits up to, and enters down from, the least common ancestor. */
+static void
+test_paths(void)
+{
+	tEvQ_Event go = { evGo, 0 };
+	tEvQ_Event reset = { evReset, 0 };
+	tEvQ_Event other = { evOther, 0 };
+	tSmeHsm hsm;
+
+	BuildHsm(&hsm);
+
+	actionlog[0] = '\0';
+	CHECK(Cwsw_Sme_FindNextStateHsm(&hsm, X, go, 0) == P1);
+	CHECK(strcmp(actionlog, "t([") == 0);
+
+	actionlog[0] = '\0';
+	CHECK(Cwsw_Sme_FindNextStateHsm(&hsm, P1, go, 0) == P2);	// within P: nothing exited or entered
+	CHECK(strcmp(actionlog, "t") == 0);
+
+	actionlog[0] = '\0';
+	CHECK(Cwsw_Sme_FindNextStateHsm(&hsm, P2, go, 0) == Q1);	// P to Q, within O
+	CHECK(strcmp(actionlog, "]t{") == 0);
+
+	actionlog[0] = '\0';
+	CHECK(Cwsw_Sme_FindNextStateHsm(&hsm, Q1, go, 0) == P2);	// inherited from Q
+	CHECK(strcmp(actionlog, "}t[") == 0);
+
+	actionlog[0] = '\0';
+	CHECK(Cwsw_Sme_FindNextStateHsm(&hsm, P2, reset, 0) == X);	// inherited from O, two levels up
+	CHECK(strcmp(actionlog, "])t") == 0);
+
+	actionlog[0] = '\0';
+	CHECK(Cwsw_Sme_FindNextStateHsm(&hsm, P1, reset, 0) == P2);	// P1's own row wins over O's
+	CHECK(strcmp(actionlog, "t") == 0);
+
+	actionlog[0] = '\0';
+	CHECK(Cwsw_Sme_FindNextStateHsm(&hsm, Q1, other, 0) == Q1);
+	CHECK(strcmp(actionlog, "") == 0);
+}
+
+/** Driven through the SME task, and through a compiled index of the flattened table. */
+static void
+test_sme_task(void)
+{
+	static tSmeIndexKey keys[MAXFLAT];
+	tSmeTransitionIndex index;
+	tEvQ_Event go = { evGo, 0 };
+	tEvQ_Event reset = { evReset, 0 };
+	pfStateHandler state;
+	tSmeHsm hsm;
+	int pass;
+
+	BuildHsm(&hsm);
+	CHECK(Cwsw_Sme_CompileTable(&index, hsm.pFlat, hsm.szFlat, keys, MAXFLAT));
+	for(pass = 0; pass < 2; ++pass)
+	{
+		hsm.pIndex = pass ? &index : NULL;
+		actionlog[0] = '\0';
+		state = X;
+		state = Cwsw_Sme__SMEHsm(&hsm, state, go, 0);
+		state = Cwsw_Sme__SMEHsm(&hsm, state, go, 0);
+		state = Cwsw_Sme__SMEHsm(&hsm, state, go, 0);
+		state = Cwsw_Sme__SMEHsm(&hsm, state, reset, 0);
+		CHECK(state == X);
+		CHECK(strcmp(actionlog, "t([t]t{})t") == 0);
+	}
+}
+
+/** Interest sets built from the flattened table include the events a state inherits. */
+static void
+test_interest(void)
+{
+	tSmeInterestEntry entries[8];
+	tSmeInterest interest;
+	tSmeHsm hsm;
+
+	BuildHsm(&hsm);
+	CHECK(Cwsw_Sme_Interest_Build(&interest, hsm.pFlat, hsm.szFlat, NULL, 0, entries, TABLE_SIZE(entries)));
+	CHECK(Cwsw_Sme_Interest_Check(&interest, P2, evReset));
+	CHECK(Cwsw_Sme_Interest_Check(&interest, Q1, evGo));
+	CHECK(Cwsw_Sme_Interest_Check(&interest, Q1, evReset));
+	CHECK(!Cwsw_Sme_Interest_Check(&interest, Q1, evOther));
+	CHECK(!Cwsw_Sme_Interest_Check(&interest, X, evReset));
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(void)
+{
+	RUN_TEST(test_resolve);
+	RUN_TEST(test_paths);
+	RUN_TEST(test_sme_task);
+	RUN_TEST(test_interest);
+	return TEST_RESULT();
+}
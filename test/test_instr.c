@@ -0,0 +1,270 @@
+/** @file
+ *	@brief	Host tests for the SME's instrumentation: the transition trace and the statistics.
+ *	Built against the engine compiled with CWSW_SME_TRACE and CWSW_SME_STATS on.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "sme_test.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme.h"
+
+#if !(CWSW_SME_TRACE) || !(CWSW_SME_STATS)
+#error "build this test with CWSW_SME_TRACE and CWSW_SME_STATS on"
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum { evGo = 1, evOther = 2 };
+
+#define TABLE_SIZE(tbl)		((uint32_t)(sizeof(tbl) / sizeof((tbl)[0])))
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tCwswClockTics	virtualclock;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+static tCwswClockTics
+Now(void)
+{
+	return virtualclock;
+}
+
+/* each state leaves on the first step a row lets it. */
+static tStateReturnCodes A(ptEvQ_Event pev, uint32_t *pextra)	{ (void)pev; (void)pextra; return kStateFinished; }
+static tStateReturnCodes B(ptEvQ_Event pev, uint32_t *pextra)	{ (void)pev; (void)pextra; return kStateFinished; }
+
+static tStateReturnCodes
+InstA(ptSmeInstCtx pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	(void)pctx;
+	(void)pev;
+	(void)pextra;
+	return kStateFinished;
+}
+
+static tTransitionTable	tbl[] = {
+	{ A, evGo, 0, 0, B, NULL, NULL, kSmeMatch_Reason1 },
+	{ B, evGo, 0, 0, A, NULL, NULL, kSmeMatch_Reason1 },
+};
+
+static tTransitionTable	insttbl[] = {
+	{ SME_INST_STATE(InstA), 0, 0, 0, SME_INST_STATE(InstA), NULL, NULL, kSmeMatch_StateOnly },
+};
+
+
+// ============================================================================
+// ----	Tests -----------------------------------------------------------------
+// ============================================================================
+
+/** Each transition leaves one record; a full ring counts what it drops. */
+static void
+test_trace(void)
+{
+	static tSmeTraceRecord records[2 * CWSW_SME_TRACE_DEPTH];
+	tEvQ_Event go = { evGo, 7 };
+	pfStateHandler state = A;
+	uint32_t count, idx;
+	char text[128];
+
+	Cwsw_Sme_SetTimeSource(Now);
+	(void)Cwsw_Sme_Trace_Drain(records, TABLE_SIZE(records));
+	virtualclock = 0;
+	for(idx = 0; idx < 3; ++idx)
+	{
+		++virtualclock;
+		state = Cwsw_Sme__SME(tbl, TABLE_SIZE(tbl), state, go, 3);
+	}
+	count = Cwsw_Sme_Trace_Drain(records, TABLE_SIZE(records));
+	CHECK_EQ(count, 3);
+	CHECK_EQ(records[0].row, 0);
+	CHECK(records[0].pfFrom == A);
+	CHECK(records[0].pfTo == B);
+	CHECK_EQ(records[1].row, 1);
+	CHECK_EQ(records[2].timestamp, 3);
+	CHECK_EQ(records[2].evId, evGo);
+	CHECK_EQ(records[2].evData, 7);
+	CHECK_EQ(records[2].extra, 3);
+	CHECK(Cwsw_Sme_Trace_Decode(&records[0], text, sizeof(text)) > 0);
+	CHECK_EQ(Cwsw_Sme_Trace_Drain(records, TABLE_SIZE(records)), 0);
+
+	// a step with no transition leaves no record.
+	(void)Cwsw_Sme__SME(tbl, TABLE_SIZE(tbl), state, (tEvQ_Event){ evOther, 0 }, 0);
+	CHECK_EQ(Cwsw_Sme_Trace_Drain(records, TABLE_SIZE(records)), 0);
+
+	for(idx = 0; idx < CWSW_SME_TRACE_DEPTH + 6; ++idx)
+	{
+		state = Cwsw_Sme__SME(tbl, TABLE_SIZE(tbl), state, go, 0);
+	}
+	CHECK_EQ(Cwsw_Sme_Trace_Drain(records, TABLE_SIZE(records)), CWSW_SME_TRACE_DEPTH);
+	CHECK_EQ(Cwsw_Sme_Trace_Lost(), 6);
+	Cwsw_Sme_SetTimeSource(NULL);
+}
+
+/** Steps, misses, entries, row hits and dwell times, for plain machines and pool instances. */
+static void
+test_stats(void)
+{
+	static pfStateHandler const states[] = { A, B };
+	static uint32_t entries[2], dwell[2 * SME_STATS_BUCKETS], rowhits[2];
+	static pfStateHandler const inststates[] = { SME_INST_STATE(InstA) };
+	static uint32_t instentries[1], instdwell[SME_STATS_BUCKETS];
+	static uint32_t sumentries[2], sumdwell[2 * SME_STATS_BUCKETS], sumrowhits[2];
+	tSmeStats stats = { 0, 0, { 0 }, states, 2, entries, dwell, rowhits, 2 };
+	tSmeStats inststats = { 0, 0, { 0 }, inststates, 1, instentries, instdwell, NULL, 0 };
+	tSmeStats sum = { 0, 0, { 0 }, states, 2, sumentries, sumdwell, sumrowhits, 2 };
+	static pfStateHandler poolstates[1];
+	static tStateReturnCodes phases[1];
+	static tCwswClockTics timers[1], entered[1];
+	static tEvQ_EventID evids[1];
+	tSmePool pool = {
+		/* .pTbl = */		insttbl,
+		/* .szTbl = */		1,
+		/* .pIndex = */		NULL,
+		/* .capacity = */	1,
+		/* .count = */		0,
+		/* .pState = */		poolstates,
+		/* .pPhase = */		phases,
+		/* .pTimer = */		timers,
+		/* .pEvId = */		evids,
+		/* .pUser = */		NULL,
+		/* .szUser = */		0,
+		/* .maxchain = */	0,
+		/* .pInterest = */	NULL,
+		/* .pHsm = */		NULL,
+		/* .pWheel = */		NULL,
+		/* .pEntered = */	entered
+	};
+	tEvQ_Event go = { evGo, 0 };
+	tEvQ_Event other = { evOther, 0 };
+	tCwswClockTics entered1 = 0;
+	tCwswClockTics entered2 = 0;
+	pfStateHandler m1 = A;
+	pfStateHandler m2 = A;
+	uint32_t idx, bucket, total;
+
+	Cwsw_Sme_SetTimeSource(Now);
+	virtualclock = 0;
+	CHECK(Cwsw_Sme_Stats_Init(&stats));
+	Cwsw_Sme_Stats_Select(&stats);
+
+	/* two plain machines, stepped alternately every 2 tics: after the first, each dwells 4 tics,
+	 * in bucket 3 (4 up to 8 tics). each keeps its own entry time.
+	 */
+	for(idx = 0; idx < 10; ++idx)
+	{
+		virtualclock += 2;
+		Cwsw_Sme_Stats_Machine(&entered1);
+		m1 = Cwsw_Sme__SME(tbl, TABLE_SIZE(tbl), m1, go, 0);
+		virtualclock += 2;
+		Cwsw_Sme_Stats_Machine(&entered2);
+		m2 = Cwsw_Sme__SME(tbl, TABLE_SIZE(tbl), m2, go, 0);
+	}
+	m1 = Cwsw_Sme__SME(tbl, TABLE_SIZE(tbl), m1, other, 0);
+	Cwsw_Sme_Stats_Machine(NULL);
+
+	CHECK_EQ(stats.steps, 21);
+	CHECK_EQ(stats.misses, 1);
+	CHECK_EQ(entries[0], 10);
+	CHECK_EQ(entries[1], 10);
+	CHECK_EQ(rowhits[0], 10);
+	CHECK_EQ(rowhits[1], 10);
+	for(bucket = 0, total = 0; bucket < SME_STATS_BUCKETS; ++bucket)
+	{
+		total += dwell[bucket] + dwell[SME_STATS_BUCKETS + bucket];
+	}
+	CHECK_EQ(total, 20);
+	CHECK_EQ(dwell[2], 1);		// machine 1's first state, entered at 0, left at 2
+	CHECK_EQ(dwell[3] + dwell[SME_STATS_BUCKETS + 3], 19);
+
+	// a pool keeps each instance's entry time itself, whichever block is selected.
+	CHECK(Cwsw_Sme_Stats_Init(&inststats));
+	Cwsw_Sme_Stats_Select(&inststats);
+	CHECK(Cwsw_Sme_Pool_Init(&pool));
+	CHECK_EQ(Cwsw_Sme_Pool_Add(&pool, SME_INST_STATE(InstA)), 0);
+	CHECK_EQ(entered[0], virtualclock);
+	for(idx = 0; idx < 6; ++idx)
+	{
+		virtualclock += 8;
+		(void)Cwsw_Sme__SMEInst(&pool, 0, other, 0);
+	}
+	CHECK_EQ(instentries[0], 6);
+	CHECK_EQ(instdwell[4], 6);	// 8 tics
+	Cwsw_Sme_Stats_Select(NULL);
+
+	// merging blocks adds their counters.
+	CHECK(Cwsw_Sme_Stats_Init(&sum));
+	CHECK(Cwsw_Sme_Stats_Snapshot(&sum, &stats));
+	CHECK(Cwsw_Sme_Stats_Snapshot(&sum, &stats));
+	CHECK_EQ(sum.steps, 42);
+	CHECK_EQ(sumentries[1], 20);
+	CHECK_EQ(sumrowhits[0], 20);
+	CHECK(!Cwsw_Sme_Stats_Snapshot(&inststats, &stats));		// destination lists too short
+	Cwsw_Sme_SetTimeSource(NULL);
+}
+
+/** A batch counts and times each of its events as a step, as that many separate calls would. */
+static void
+test_batch_stats(void)
+{
+	static pfStateHandler const states[] = { A, B };
+	static uint32_t entries[2], dwell[2 * SME_STATS_BUCKETS], rowhits[2];
+	static tEvQ_Event const events[] = { { evGo, 0 }, { evOther, 0 }, { evGo, 0 }, { evGo, 0 }, { evOther, 0 } };
+	tSmeStats stats = { 0, 0, { 0 }, states, 2, entries, dwell, rowhits, 2 };
+	uint32_t bucket, total;
+
+	Cwsw_Sme_SetTimeSource(Now);
+	virtualclock = 0;
+	CHECK(Cwsw_Sme_Stats_Init(&stats));
+	Cwsw_Sme_Stats_Select(&stats);
+	CHECK(Cwsw_Sme__SMEBatch(tbl, TABLE_SIZE(tbl), A, events, NULL, TABLE_SIZE(events), NULL) == B);
+	Cwsw_Sme_Stats_Select(NULL);
+
+	CHECK_EQ(stats.steps, TABLE_SIZE(events));
+	CHECK_EQ(stats.misses, 2);
+	CHECK_EQ(entries[0], 1);
+	CHECK_EQ(entries[1], 2);
+	for(bucket = 0, total = 0; bucket < SME_STATS_BUCKETS; ++bucket)
+	{
+		total += stats.latency[bucket];
+	}
+	CHECK_EQ(total, TABLE_SIZE(events));
+	Cwsw_Sme_SetTimeSource(NULL);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(void)
+{
+	RUN_TEST(test_trace);
+	RUN_TEST(test_stats);
+	RUN_TEST(test_batch_stats);
+	return TEST_RESULT();
+}
@@ -0,0 +1,256 @@
+/** @file
+ *	@brief	Host tests for the lock-free multi-producer / single-consumer event queues.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <pthread.h>
+#include <sched.h>			/* sched_yield() */
+#include <stdatomic.h>
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "sme_test.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme_mpsc.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/** Instances in the pool. */
+#define NINST				(4)
+
+/** Capacity of each instance's queue. */
+#define SZQUEUE				(8)
+
+/** Producer threads, and the events each posts, in the multi-producer test. */
+#define NPRODUCERS			(4)
+#define NEVENTS				(50000)
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static pfStateHandler		states[NINST];
+static tStateReturnCodes	phases[NINST];
+static tCwswClockTics		timers[NINST];
+static tEvQ_EventID			evids[NINST];
+static tSmePool				pool;
+
+/* written only by the handler, on the consuming thread. */
+static uint32_t				received[NINST];
+static uint32_t				lastdata[NINST];
+static uint32_t				lastseq[NPRODUCERS];
+static int					outoforder;
+
+static ptSmeMpsc			pMpsc;
+static atomic_int			producing;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/** Records each event; in the multi-producer test, evId is the producer and evData its sequence. */
+static tStateReturnCodes
+Record(ptSmeInstCtx pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	(void)pextra;
+	++received[pctx->inst];
+	lastdata[pctx->inst] = pev->evData;
+	if((pev->evId >= 0) && (pev->evId < NPRODUCERS))
+	{
+		if(pev->evData != lastseq[pev->evId] + 1)	{ ++outoforder; }
+		lastseq[pev->evId] = pev->evData;
+	}
+	SME_INST_PHASE(pctx) = kStateOperational;
+	return kStateOperational;
+}
+
+static tTransitionTable	tbl[] = {
+	{ SME_INST_STATE(Record), -1, 0, 0, SME_INST_STATE(Record), NULL, NULL, kSmeMatch_Reason1 },
+};
+
+static void
+Setup(void)
+{
+	tSmePool p = {
+		/* .pTbl = */		tbl,
+		/* .szTbl = */		1,
+		/* .pIndex = */		NULL,
+		/* .capacity = */	NINST,
+		/* .count = */		0,
+		/* .pState = */		states,
+		/* .pPhase = */		phases,
+		/* .pTimer = */		timers,
+		/* .pEvId = */		evids,
+		/* .pUser = */		NULL,
+		/* .szUser = */		0,
+		/* .maxchain = */	0,
+		/* .pInterest = */	NULL,
+		/* .pHsm = */		NULL,
+		/* .pWheel = */		NULL,
+		/* .pEntered = */	NULL
+	};
+	tSmeInstance inst;
+
+	pool = p;
+	CHECK(Cwsw_Sme_Pool_Init(&pool));
+	for(inst = 0; inst < NINST; ++inst)
+	{
+		CHECK_EQ(Cwsw_Sme_Pool_Add(&pool, SME_INST_STATE(Record)), inst);
+	}
+	memset(received, 0, sizeof(received));
+	memset(lastdata, 0, sizeof(lastdata));
+	memset(lastseq, 0, sizeof(lastseq));
+	outoforder = 0;
+}
+
+static void *
+Producer(void *pArg)
+{
+	tEvQ_Event ev;
+	uint32_t seq;
+
+	ev.evId = (tEvQ_EventID)(intptr_t)pArg;
+	for(seq = 1; seq <= NEVENTS; ++seq)
+	{
+		ev.evData = seq;
+		while(!Cwsw_Sme_Mpsc_Post(pMpsc, 0, ev, 0))	{ (void)sched_yield(); }	// full: let the consumer make room
+	}
+	(void)atomic_fetch_sub(&producing, 1);
+	return NULL;
+}
+
+
+// ============================================================================
+// ----	Tests -----------------------------------------------------------------
+// ============================================================================
+
+static void
+test_fifo(void)
+{
+	tEvQ_Event ev = { NPRODUCERS, 0 };
+	uint32_t idx;
+
+	Setup();
+	CHECK(Cwsw_Sme_Mpsc_Create(&pool, 6) == NULL);			// not a power of 2
+	pMpsc = Cwsw_Sme_Mpsc_Create(&pool, SZQUEUE);
+	CHECK(pMpsc != NULL);
+	if(!pMpsc)	{ return; }
+
+	CHECK(Cwsw_Sme_Mpsc_IsEmpty(pMpsc, 1));
+	for(idx = 1; idx <= SZQUEUE; ++idx)
+	{
+		ev.evData = idx;
+		CHECK(Cwsw_Sme_Mpsc_Post(pMpsc, 1, ev, 0));
+	}
+	CHECK(!Cwsw_Sme_Mpsc_Post(pMpsc, 1, ev, 0));				// full
+	CHECK(Cwsw_Sme_Mpsc_Post(pMpsc, 2, ev, 0));				// other queues are not
+	CHECK(!Cwsw_Sme_Mpsc_Post(pMpsc, NINST, ev, 0));			// not allocated; not counted as rejected
+	CHECK_EQ(Cwsw_Sme_Mpsc_Rejected(pMpsc), 1);
+
+	CHECK_EQ(Cwsw_Sme_Mpsc_Peek(pMpsc, 1)->ev.evData, 1);
+	CHECK_EQ(Cwsw_Sme_Mpsc_Drain(pMpsc, 1, 3), 3);
+	CHECK_EQ(lastdata[1], 3);
+	CHECK_EQ(Cwsw_Sme_Mpsc_DrainPool(pMpsc, 0), SZQUEUE - 3 + 1);
+	CHECK_EQ(received[1], SZQUEUE);
+	CHECK_EQ(lastdata[1], SZQUEUE);
+	CHECK_EQ(received[2], 1);
+	CHECK(Cwsw_Sme_Mpsc_IsEmpty(pMpsc, 1));
+
+	Cwsw_Sme_Mpsc_Destroy(pMpsc);
+}
+
+/** A reserved slot holds back the slots after it until it is committed. */
+static void
+test_reserve_commit(void)
+{
+	ptSmeMpscEntry pFirst;
+	ptSmeMpscEntry pSecond;
+
+	Setup();
+	pMpsc = Cwsw_Sme_Mpsc_Create(&pool, SZQUEUE);
+	CHECK(pMpsc != NULL);
+	if(!pMpsc)	{ return; }
+
+	pFirst = Cwsw_Sme_Mpsc_Reserve(pMpsc, 0);
+	pSecond = Cwsw_Sme_Mpsc_Reserve(pMpsc, 0);
+	CHECK((pFirst != NULL) && (pSecond != NULL) && (pFirst != pSecond));
+	if(!pFirst || !pSecond)	{ return; }
+
+	pSecond->ev.evId = NPRODUCERS;	pSecond->ev.evData = 2;	pSecond->extra = 0;
+	Cwsw_Sme_Mpsc_Commit(pMpsc, pSecond);
+	CHECK(Cwsw_Sme_Mpsc_IsEmpty(pMpsc, 0));
+	CHECK_EQ(Cwsw_Sme_Mpsc_Drain(pMpsc, 0, 0), 0);
+
+	pFirst->ev.evId = NPRODUCERS;	pFirst->ev.evData = 1;	pFirst->extra = 0;
+	Cwsw_Sme_Mpsc_Commit(pMpsc, pFirst);
+	CHECK_EQ(Cwsw_Sme_Mpsc_Drain(pMpsc, 0, 0), 2);
+	CHECK_EQ(lastdata[0], 2);
+
+	Cwsw_Sme_Mpsc_Destroy(pMpsc);
+}
+
+/** Concurrent producers into one small queue: nothing lost, each producer's events in order. */
+static void
+test_producers(void)
+{
+	pthread_t threads[NPRODUCERS];
+	intptr_t idx;
+
+	Setup();
+	pMpsc = Cwsw_Sme_Mpsc_Create(&pool, SZQUEUE);
+	CHECK(pMpsc != NULL);
+	if(!pMpsc)	{ return; }
+
+	atomic_store(&producing, NPRODUCERS);
+	for(idx = 0; idx < NPRODUCERS; ++idx)
+	{
+		CHECK_EQ(pthread_create(&threads[idx], NULL, Producer, (void *)idx), 0);
+	}
+	while(atomic_load(&producing) > 0)
+	{
+		if(!Cwsw_Sme_Mpsc_Drain(pMpsc, 0, 0))	{ (void)sched_yield(); }
+	}
+	for(idx = 0; idx < NPRODUCERS; ++idx)
+	{
+		(void)pthread_join(threads[idx], NULL);
+	}
+	(void)Cwsw_Sme_Mpsc_Drain(pMpsc, 0, 0);
+
+	CHECK_EQ(received[0], NPRODUCERS * NEVENTS);
+	CHECK_EQ(outoforder, 0);
+	for(idx = 0; idx < NPRODUCERS; ++idx)
+	{
+		CHECK_EQ(lastseq[idx], NEVENTS);
+	}
+	Cwsw_Sme_Mpsc_Destroy(pMpsc);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(void)
+{
+	RUN_TEST(test_fifo);
+	RUN_TEST(test_reserve_commit);
+	RUN_TEST(test_producers);
+	return TEST_RESULT();
+}
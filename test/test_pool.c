@@ -0,0 +1,313 @@
+/** @file
+ *	@brief	Host tests for SME instance pools and event-interest filtering.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "sme_test.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum { evTick = 1, evGo = 2, evOther = 3 };
+
+#define TABLE_SIZE(tbl)		((uint32_t)(sizeof(tbl) / sizeof((tbl)[0])))
+
+/** Instances in the pools built here. */
+#define NINST				(4)
+
+/** Ticks each cycling state stays operational. */
+#define DWELL				(3)
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static pfStateHandler		states[NINST];
+static tStateReturnCodes	phases[NINST];
+static tCwswClockTics		timers[NINST];
+static tEvQ_EventID			evids[NINST];
+static uint32_t				user[NINST];
+
+static int					entries[NINST][2];
+static int					seen[NINST];
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/** A state written as the template writes its instance-aware states: the phase, timer and exit
+ *	reason live in the pool.
+ */
+static tStateReturnCodes
+Cycle(int which, ptSmeInstCtx pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	switch(SME_INST_PHASE(pctx))
+	{
+	case kStateUninit:
+	default:
+		++entries[pctx->inst][which];
+		SME_INST_EVID(pctx) = pev->evId;
+		SME_INST_TIMER(pctx) = DWELL;
+		SME_INST_PHASE(pctx) = kStateOperational;
+		break;
+
+	case kStateOperational:
+		if(--SME_INST_TIMER(pctx) <= 0)	{ SME_INST_PHASE(pctx) = kStateExit; }
+		break;
+
+	case kStateExit:
+		pev->evId = SME_INST_EVID(pctx);
+		pev->evData = 0;
+		*pextra = 0;
+		SME_INST_PHASE(pctx) = kStateFinished;
+		break;
+	}
+	return SME_INST_PHASE(pctx);
+}
+
+static tStateReturnCodes CycleA(ptSmeInstCtx pctx, ptEvQ_Event pev, uint32_t *pextra)	{ return Cycle(0, pctx, pev, pextra); }
+static tStateReturnCodes CycleB(ptSmeInstCtx pctx, ptEvQ_Event pev, uint32_t *pextra)	{ return Cycle(1, pctx, pev, pextra); }
+
+/** Waits for evGo, counting the events it is given while operational. */
+static tStateReturnCodes
+Listen(ptSmeInstCtx pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	switch(SME_INST_PHASE(pctx))
+	{
+	case kStateUninit:
+	default:
+		SME_INST_PHASE(pctx) = kStateOperational;
+		break;
+
+	case kStateOperational:
+		++seen[pctx->inst];
+		if(pev->evId == evGo)	{ SME_INST_PHASE(pctx) = kStateExit; }
+		break;
+
+	case kStateExit:
+		pev->evId = evGo;
+		pev->evData = 0;
+		*pextra = 0;
+		SME_INST_PHASE(pctx) = kStateFinished;
+		break;
+	}
+	return SME_INST_PHASE(pctx);
+}
+
+static tStateReturnCodes
+Done(ptSmeInstCtx pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	(void)pev;
+	(void)pextra;
+	SME_INST_PHASE(pctx) = kStateOperational;
+	return kStateOperational;
+}
+
+static tTransitionTable	cycletbl[] = {
+	{ SME_INST_STATE(CycleA), 0, 0, 0, SME_INST_STATE(CycleB), NULL, NULL, kSmeMatch_StateOnly },
+	{ SME_INST_STATE(CycleB), 0, 0, 0, SME_INST_STATE(CycleA), NULL, NULL, kSmeMatch_StateOnly },
+};
+
+static tTransitionTable	listentbl[] = {
+	{ SME_INST_STATE(Listen), evGo, 0, 0, SME_INST_STATE(Done), NULL, NULL, kSmeMatch_Reason1 },
+};
+
+static void
+MakePool(ptSmePool pPool, ptTransitionTable pTbl, uint32_t szTbl, uint32_t maxchain)
+{
+	tSmePool pool = {
+		/* .pTbl = */		pTbl,
+		/* .szTbl = */		szTbl,
+		/* .pIndex = */		NULL,
+		/* .capacity = */	NINST,
+		/* .count = */		0,
+		/* .pState = */		states,
+		/* .pPhase = */		phases,
+		/* .pTimer = */		timers,
+		/* .pEvId = */		evids,
+		/* .pUser = */		(uint8_t *)user,
+		/* .szUser = */		sizeof(user[0]),
+		/* .maxchain = */	maxchain,
+		/* .pInterest = */	NULL,
+		/* .pHsm = */		NULL,
+		/* .pWheel = */		NULL,
+		/* .pEntered = */	NULL
+	};
+	*pPool = pool;
+	memset(entries, 0, sizeof(entries));
+	memset(seen, 0, sizeof(seen));
+}
+
+
+// ============================================================================
+// ----	Tests -----------------------------------------------------------------
+// ============================================================================
+
+/** The template's instance-aware states cycle, stepwise and run to completion alike. */
+static void
+test_cycle(void)
+{
+	tEvQ_Event tick = { evTick, 0 };
+	uint32_t maxchain, step;
+	tSmePool pool;
+
+	for(maxchain = 0; maxchain < 3; ++maxchain)
+	{
+		MakePool(&pool, cycletbl, TABLE_SIZE(cycletbl), maxchain);
+		CHECK(Cwsw_Sme_Pool_Init(&pool));
+		CHECK_EQ(Cwsw_Sme_Pool_Add(&pool, SME_INST_STATE(CycleA)), 0);
+
+		for(step = 0; step < 40; ++step)
+		{
+			(void)Cwsw_Sme__SMEInst(&pool, 0, tick, 0);
+		}
+		if(maxchain == 0)
+		{
+			// entry, DWELL operational steps, exit and transition: DWELL + 2 steps per state.
+			CHECK_EQ(entries[0][0], 4);
+			CHECK_EQ(entries[0][1], 4);
+		}
+		else
+		{
+			// the exit, transition and next entry share the step that ends the dwell.
+			CHECK_EQ(entries[0][0], 7);
+			CHECK_EQ(entries[0][1], 7);
+		}
+	}
+}
+
+/** Instances are independent, and the pool refuses more than its capacity. */
+static void
+test_instances(void)
+{
+	tEvQ_Event tick = { evTick, 0 };
+	tSmeInstance inst;
+	tSmePool pool;
+	uint32_t step;
+
+	MakePool(&pool, cycletbl, TABLE_SIZE(cycletbl), 0);
+	CHECK(Cwsw_Sme_Pool_Init(&pool));
+	for(inst = 0; inst < NINST; ++inst)
+	{
+		CHECK_EQ(Cwsw_Sme_Pool_Add(&pool, SME_INST_STATE((inst % 2) ? CycleB : CycleA)), inst);
+	}
+	CHECK_EQ(Cwsw_Sme_Pool_Add(&pool, SME_INST_STATE(CycleA)), kSmeInstanceNone);
+
+	for(step = 0; step < 6; ++step)
+	{
+		Cwsw_Sme__SMEPool(&pool, tick, 0);
+	}
+	(void)Cwsw_Sme__SMEInst(&pool, 3, tick, 0);
+
+	CHECK_EQ(entries[0][0], 1);		CHECK_EQ(entries[0][1], 1);
+	CHECK_EQ(entries[1][1], 1);		CHECK_EQ(entries[1][0], 1);
+	CHECK_EQ(entries[2][0], 1);		CHECK_EQ(entries[2][1], 1);
+	CHECK_EQ(entries[3][1], 1);		CHECK_EQ(entries[3][0], 1);
+	CHECK(states[0] == SME_INST_STATE(CycleB));
+	CHECK(states[1] == SME_INST_STATE(CycleA));
+	CHECK_EQ(timers[3], DWELL - 1);
+	CHECK_EQ(timers[1], DWELL);
+}
+
+static void
+test_batch(void)
+{
+	tSmeInstEvent items[] = {
+		{ 0, { evGo, 0 }, 0 },			// still entering: the entry action takes this one
+		{ 1, { evGo, 0 }, 0 },
+		{ 0, { evGo, 0 }, 0 },
+		{ NINST, { evGo, 0 }, 0 },		// not allocated
+		{ 0, { evTick, 0 }, 0 },
+	};
+	pfStateHandler after[TABLE_SIZE(items)];
+	tSmePool pool;
+
+	MakePool(&pool, listentbl, TABLE_SIZE(listentbl), 0);
+	CHECK(Cwsw_Sme_Pool_Init(&pool));
+	CHECK_EQ(Cwsw_Sme_Pool_Add(&pool, SME_INST_STATE(Listen)), 0);
+	CHECK_EQ(Cwsw_Sme_Pool_Add(&pool, SME_INST_STATE(Listen)), 1);
+
+	CHECK_EQ(Cwsw_Sme__SMEInstBatch(&pool, items, TABLE_SIZE(items), after), 4);
+	CHECK(after[0] == SME_INST_STATE(Listen));
+	CHECK(after[1] == SME_INST_STATE(Listen));
+	CHECK(after[2] == SME_INST_STATE(Listen));
+	CHECK(after[3] == NULL);
+	CHECK(after[4] == SME_INST_STATE(Done));
+	CHECK(states[1] == SME_INST_STATE(Listen));
+}
+
+/** Operational states only receive the events they react to; other phases receive everything. */
+static void
+test_interest(void)
+{
+	tSmeReaction reactions[] = { { SME_INST_STATE(Listen), evTick } };
+	tSmeInterestEntry ientries[4];
+	tSmeInterest interest;
+	tEvQ_Event tick = { evTick, 0 };
+	tEvQ_Event other = { evOther, 0 };
+	tEvQ_Event go = { evGo, 0 };
+	tSmePool pool;
+
+	CHECK(Cwsw_Sme_Interest_Build(&interest, listentbl, TABLE_SIZE(listentbl), reactions, TABLE_SIZE(reactions), ientries, TABLE_SIZE(ientries)));
+	CHECK(Cwsw_Sme_Interest_Check(&interest, SME_INST_STATE(Listen), evGo));
+	CHECK(Cwsw_Sme_Interest_Check(&interest, SME_INST_STATE(Listen), evTick));
+	CHECK(!Cwsw_Sme_Interest_Check(&interest, SME_INST_STATE(Listen), evOther));
+	CHECK(Cwsw_Sme_Interest_Check(&interest, SME_INST_STATE(Done), evOther));	// not in the sets
+	CHECK_EQ(interest.dispatched, 3);
+	CHECK_EQ(interest.skipped, 1);
+	interest.dispatched = 0;
+	interest.skipped = 0;
+
+	MakePool(&pool, listentbl, TABLE_SIZE(listentbl), 0);
+	pool.pInterest = &interest;
+	CHECK(Cwsw_Sme_Pool_Init(&pool));
+	CHECK_EQ(Cwsw_Sme_Pool_Add(&pool, SME_INST_STATE(Listen)), 0);
+
+	(void)Cwsw_Sme__SMEInst(&pool, 0, other, 0);		// entry: not filtered
+	(void)Cwsw_Sme__SMEInst(&pool, 0, other, 0);
+	(void)Cwsw_Sme__SMEInst(&pool, 0, other, 0);
+	(void)Cwsw_Sme__SMEInst(&pool, 0, tick, 0);
+	CHECK_EQ(seen[0], 1);
+	CHECK_EQ(interest.skipped, 2);
+	CHECK_EQ(interest.dispatched, 1);
+
+	(void)Cwsw_Sme__SMEInst(&pool, 0, go, 0);
+	(void)Cwsw_Sme__SMEInst(&pool, 0, other, 0);		// exit: not filtered
+	CHECK_EQ(seen[0], 2);
+	CHECK(states[0] == SME_INST_STATE(Done));
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(void)
+{
+	RUN_TEST(test_cycle);
+	RUN_TEST(test_instances);
+	RUN_TEST(test_batch);
+	RUN_TEST(test_interest);
+	return TEST_RESULT();
+}
@@ -0,0 +1,224 @@
+/** @file
+ *	@brief	Host tests for the scripted-input replay.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdio.h>
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "sme_test.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme_replay.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/** Samples recorded for inspection; later ones are only counted. */
+#define MAXSAMPLES			(16)
+
+/** Scratch file for the file replay, in the directory the test runs in. */
+#define SCRIPTFILE			"test_replay.tmp"
+
+static char const	script[] =
+	"# two presses of button 1, then one of button 2, bouncing\n"
+	"101      1101111110000   # 5 tics, then press and release\n"
+	"0d20     01011          \n"
+	"0x10     2220202200     # hex delay\n"
+	"0b11\t1\n";
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tCwswClockTics	sampleat[MAXSAMPLES];
+static uint8_t			contact[MAXSAMPLES];
+static uint32_t			nsamples;
+static uint32_t			nticks;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+static void
+Input(void *pCtx, tCwswClockTics now, uint8_t closed)
+{
+	ptSmeReplay pReplay = (ptSmeReplay)pCtx;
+
+	if(nsamples < MAXSAMPLES)
+	{
+		sampleat[nsamples] = now;
+		contact[nsamples] = closed;
+	}
+	++nsamples;
+	Cwsw_Sme_Replay_Record(pReplay, &closed, sizeof(closed));
+}
+
+static void
+Tick(void *pCtx, tCwswClockTics now)
+{
+	(void)pCtx;
+	(void)now;
+	++nticks;
+}
+
+static void
+Start(ptSmeReplay pReplay, tCwswClockTics period, tCwswClockTics sample)
+{
+	memset(pReplay, 0, sizeof(*pReplay));
+	pReplay->pfInput = Input;
+	pReplay->pfTick = Tick;
+	pReplay->pCtx = pReplay;
+	pReplay->period = period;
+	pReplay->sample = sample;
+	nsamples = 0;
+	nticks = 0;
+	CHECK(Cwsw_Sme_Replay_Init(pReplay, 0));
+}
+
+static void
+Run(ptSmeReplay pReplay, char const *pText)
+{
+	(void)Cwsw_Sme_Replay_Feed(pReplay, pText, strlen(pText));
+	Cwsw_Sme_Replay_Finish(pReplay);
+}
+
+
+// ============================================================================
+// ----	Tests -----------------------------------------------------------------
+// ============================================================================
+
+/** Time values are binary unless prefixed. */
+static void
+test_time_values(void)
+{
+	static struct {
+		char const		*pText;
+		tCwswClockTics	first;
+		uint32_t		errors;
+	} const cases[] = {
+		{ "10 1101",		2,	0 },
+		{ "0b10 1101",		2,	0 },
+		{ "0d10 1101",		10,	0 },
+		{ "0x10 1101",		16,	0 },
+		{ "0XfF 1",			255,	0 },
+		{ "12 1101",		0,	1 },	// not binary
+		{ "0d 1",			0,	1 },	// prefix with no digits
+		{ "0d99999999999 1",	0,	1 },	// too large
+	};
+	tSmeReplay replay;
+	uint32_t idx;
+
+	for(idx = 0; idx < sizeof(cases) / sizeof(cases[0]); ++idx)
+	{
+		Start(&replay, 0, 1);
+		Run(&replay, cases[idx].pText);
+		CHECK_EQ(sampleat[0], cases[idx].first);
+		CHECK_EQ(replay.errors, cases[idx].errors);
+	}
+}
+
+/** Samples hold for their duration; delays run from the end of the previous string; ticks keep
+ *	their period throughout.
+ */
+static void
+test_timeline(void)
+{
+	tSmeReplay replay;
+
+	Start(&replay, 4, 2);
+	Run(&replay, script);
+	CHECK_EQ(replay.errors, 0);
+	CHECK_EQ(nsamples, 13 + 5 + 10 + 1);
+	CHECK_EQ(replay.samples, nsamples);
+	CHECK_EQ(sampleat[0], 5);
+	CHECK_EQ(contact[0], 1);
+	CHECK_EQ(sampleat[1], 7);
+	CHECK_EQ(contact[2], 0);
+	CHECK_EQ(sampleat[13], 5 + (13 * 2) + 20);
+	CHECK_EQ(replay.now, 5 + (13 * 2) + 20 + (5 * 2) + 16 + (10 * 2) + 3 + 2);
+	CHECK_EQ(replay.line, 6);
+	CHECK_EQ(nticks, (uint32_t)replay.now / 4);
+	CHECK_EQ(Cwsw_Sme_Replay_Clock(), replay.now);
+}
+
+/** However the script is split, the run is the same. */
+static void
+test_chunks(void)
+{
+	tSmeReplay replay;
+	uint64_t whole;
+	size_t idx;
+
+	Start(&replay, 3, 1);
+	Run(&replay, script);
+	whole = Cwsw_Sme_Replay_Digest(&replay);
+
+	Start(&replay, 3, 1);
+	for(idx = 0; script[idx]; ++idx)
+	{
+		CHECK_EQ(Cwsw_Sme_Replay_Feed(&replay, &script[idx], 1), 1);
+	}
+	Cwsw_Sme_Replay_Finish(&replay);
+	CHECK(Cwsw_Sme_Replay_Digest(&replay) == whole);
+
+	// a different script gives a different digest.
+	Start(&replay, 3, 1);
+	Run(&replay, "101 1101111110001");
+	CHECK(Cwsw_Sme_Replay_Digest(&replay) != whole);
+}
+
+static void
+test_file(void)
+{
+	tSmeReplay replay;
+	uint64_t whole;
+	FILE *pFile;
+
+	Start(&replay, 3, 1);
+	Run(&replay, script);
+	whole = Cwsw_Sme_Replay_Digest(&replay);
+
+	pFile = fopen(SCRIPTFILE, "wb");
+	CHECK(pFile != NULL);
+	if(!pFile)	{ return; }
+	CHECK_EQ(fwrite(script, 1, strlen(script), pFile), strlen(script));
+	(void)fclose(pFile);
+
+	Start(&replay, 3, 1);
+	CHECK(Cwsw_Sme_Replay_File(&replay, SCRIPTFILE));
+	CHECK(Cwsw_Sme_Replay_Digest(&replay) == whole);
+	(void)remove(SCRIPTFILE);
+
+	CHECK(!Cwsw_Sme_Replay_File(&replay, SCRIPTFILE));
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(void)
+{
+	RUN_TEST(test_time_values);
+	RUN_TEST(test_timeline);
+	RUN_TEST(test_chunks);
+	RUN_TEST(test_file);
+	return TEST_RESULT();
+}
@@ -0,0 +1,349 @@
+/** @file
+ *	@brief	Host tests for the multi-threaded scheduler of SME instance pools.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <pthread.h>
+#include <sched.h>			/* sched_yield() */
+#include <stdatomic.h>
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "sme_test.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme_sched.h"
+#include "cwsw_sme_wheel.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum { evTick = 1, evWork = 5, evRelay = 6 };
+
+/** Instances in the pool, and events posted to each. */
+#define NINST				(500)
+#define NEVENTS				(100)
+
+/** Worker threads. */
+#define NWORKERS			(4)
+
+/** Capacity of each instance's inbox; small, so that posts are refused and retried. */
+#define SZINBOX				(16)
+
+/** Stress test: producer threads, the events each posts per round, and the instances they post
+ *	to. Each round runs with a different number of workers.
+ */
+#define NPRODUCERS			(4)
+#define STRESS_EVENTS		(4000)
+#define STRESS_INST			(64)
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static pfStateHandler		states[NINST];
+static tStateReturnCodes	phases[NINST];
+static tCwswClockTics		timers[NINST];
+static tEvQ_EventID			evids[NINST];
+static tSmePool				pool;
+
+/* each instance is run by one worker at a time, so its own elements need no atomics. */
+static uint32_t				lastdata[NINST];
+static uint32_t				received[NINST];
+static atomic_int			outoforder;
+
+/* stress test: a flag per instance, set while a worker runs it; the last sequence number seen
+ * from each producer; and the relays the handlers post onward.
+ */
+static atomic_int			running[STRESS_INST];
+static uint32_t				lastseq[STRESS_INST][NPRODUCERS];
+static atomic_int			overlaps;
+static atomic_uint			relayed;
+static ptSmeSched			pStressSched;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/** Records the events it is given, which must arrive in the order they were posted. */
+static tStateReturnCodes
+Worker(ptSmeInstCtx pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	(void)pextra;
+	if(pev->evData <= lastdata[pctx->inst])	{ (void)atomic_fetch_add(&outoforder, 1); }
+	lastdata[pctx->inst] = pev->evData;
+	++received[pctx->inst];
+	SME_INST_PHASE(pctx) = kStateOperational;
+	return kStateOperational;
+}
+
+static tTransitionTable	tbl[] = {
+	{ SME_INST_STATE(Worker), evWork, 0, 0, SME_INST_STATE(Worker), NULL, NULL, kSmeMatch_Reason1 },
+};
+
+/** Checks that no other worker is running this instance, and that each producer's events arrive
+ *	in the order that producer posted them; passes every fourth event on to the next instance.
+ */
+static tStateReturnCodes
+Stress(ptSmeInstCtx pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	tSmeInstance inst = pctx->inst;
+	uint32_t producer = *pextra;
+	tEvQ_Event relay;
+
+	if(atomic_exchange(&running[inst], 1))	{ (void)atomic_fetch_add(&overlaps, 1); }
+
+	if(pev->evId == evWork)
+	{
+		if(pev->evData <= lastseq[inst][producer])	{ (void)atomic_fetch_add(&outoforder, 1); }
+		lastseq[inst][producer] = pev->evData;
+		++received[inst];
+		if((pev->evData % 4) == 0)
+		{
+			// posted from a worker; dropped, rather than retried, if the inbox is full.
+			relay.evId = evRelay;
+			relay.evData = pev->evData;
+			if(Cwsw_Sme_Sched_Post(pStressSched, (inst + 1) % STRESS_INST, relay, producer))
+			{
+				(void)atomic_fetch_add(&relayed, 1);
+			}
+		}
+	}
+	atomic_store(&running[inst], 0);
+
+	SME_INST_PHASE(pctx) = kStateOperational;
+	return kStateOperational;
+}
+
+static tTransitionTable	stresstbl[] = {
+	{ SME_INST_STATE(Stress), 0, 0, 0, SME_INST_STATE(Stress), NULL, NULL, kSmeMatch_StateOnly },
+};
+
+/** Post this producer's events, in sequence, across every instance. */
+static void *
+StressProducer(void *pArg)
+{
+	uint32_t producer = (uint32_t)(uintptr_t)pArg;
+	tEvQ_Event ev;
+	uint32_t seq;
+
+	ev.evId = evWork;
+	for(seq = 1; seq <= STRESS_EVENTS; ++seq)
+	{
+		ev.evData = seq;
+		while(!Cwsw_Sme_Sched_Post(pStressSched, (seq * (producer + 1)) % STRESS_INST, ev, producer))
+		{
+			(void)sched_yield();
+		}
+	}
+	return NULL;
+}
+
+static void
+Setup(ptSmeInterest pInterest)
+{
+	tSmePool p = {
+		/* .pTbl = */		tbl,
+		/* .szTbl = */		1,
+		/* .pIndex = */		NULL,
+		/* .capacity = */	NINST,
+		/* .count = */		0,
+		/* .pState = */		states,
+		/* .pPhase = */		phases,
+		/* .pTimer = */		timers,
+		/* .pEvId = */		evids,
+		/* .pUser = */		NULL,
+		/* .szUser = */		0,
+		/* .maxchain = */	0,
+		/* .pInterest = */	pInterest,
+		/* .pHsm = */		NULL,
+		/* .pWheel = */		NULL,
+		/* .pEntered = */	NULL
+	};
+	tSmeInstance inst;
+
+	pool = p;
+	CHECK(Cwsw_Sme_Pool_Init(&pool));
+	for(inst = 0; inst < NINST; ++inst)
+	{
+		CHECK_EQ(Cwsw_Sme_Pool_Add(&pool, SME_INST_STATE(Worker)), inst);
+	}
+	memset(lastdata, 0, sizeof(lastdata));
+	memset(received, 0, sizeof(received));
+	atomic_store(&outoforder, 0);
+}
+
+/** Post every event to every instance, retrying refused posts. */
+static void
+PostAll(ptSmeSched pSched, bool mixed)
+{
+	tEvQ_Event ev;
+	uint32_t seq;
+	tSmeInstance inst;
+
+	for(seq = 1; seq <= NEVENTS; ++seq)
+	{
+		// with `mixed`, every other event is one the instances have no interest in.
+		ev.evId = (mixed && ((seq % 2) == 0)) ? evTick : evWork;
+		ev.evData = seq;
+		for(inst = 0; inst < NINST; ++inst)
+		{
+			while(!Cwsw_Sme_Sched_Post(pSched, inst, ev, 0))	{ (void)sched_yield(); }
+		}
+	}
+}
+
+
+// ============================================================================
+// ----	Tests -----------------------------------------------------------------
+// ============================================================================
+
+/** Every event is run, once, in the order posted to its instance. */
+static void
+test_delivery(void)
+{
+	tSmeSchedStats stats;
+	ptSmeSched pSched;
+	tSmeInstance inst;
+	tSmeWheel wheel;
+	int missing = 0;
+
+	Setup(NULL);
+	CHECK(Cwsw_Sme_Sched_Create(&pool, NWORKERS, 12) == NULL);		// inbox not a power of 2
+	pool.pWheel = &wheel;
+	CHECK(Cwsw_Sme_Sched_Create(&pool, NWORKERS, SZINBOX) == NULL);	// a wheel belongs to one thread
+	pool.pWheel = NULL;
+	pSched = Cwsw_Sme_Sched_Create(&pool, NWORKERS, SZINBOX);
+	CHECK(pSched != NULL);
+	if(!pSched)	{ return; }
+
+	PostAll(pSched, false);
+	Cwsw_Sme_Sched_Drain(pSched);
+	Cwsw_Sme_Sched_Stats(pSched, &stats);
+
+	for(inst = 0; inst < NINST; ++inst)
+	{
+		if((received[inst] != NEVENTS) || (lastdata[inst] != NEVENTS))	{ ++missing; }
+	}
+	CHECK_EQ(missing, 0);
+	CHECK_EQ(atomic_load(&outoforder), 0);
+	CHECK_EQ(stats.events, (uint64_t)NINST * NEVENTS);
+	CHECK(stats.runs > 0);
+	CHECK(stats.runs <= stats.events);
+	Cwsw_Sme_Sched_Destroy(pSched);
+}
+
+/** With event filtering, instances on several workers see only the events they react to. */
+static void
+test_interest(void)
+{
+	tSmeInterestEntry entries[2];
+	tSmeInterest interest;
+	ptSmeSched pSched;
+	tSmeInstance inst;
+	int wrong = 0;
+
+	CHECK(Cwsw_Sme_Interest_Build(&interest, tbl, 1, NULL, 0, entries, 2));
+	Setup(&interest);
+	pSched = Cwsw_Sme_Sched_Create(&pool, NWORKERS, SZINBOX);
+	CHECK(pSched != NULL);
+	if(!pSched)	{ return; }
+
+	PostAll(pSched, true);
+	Cwsw_Sme_Sched_Drain(pSched);
+
+	// the first event completes the entry action, filtered or not.
+	for(inst = 0; inst < NINST; ++inst)
+	{
+		if((received[inst] != (NEVENTS / 2)) || (lastdata[inst] != NEVENTS - 1))	{ ++wrong; }
+	}
+	CHECK_EQ(wrong, 0);
+	CHECK_EQ(atomic_load(&outoforder), 0);
+	CHECK_EQ(interest.dispatched, NINST * ((NEVENTS / 2) - 1));
+	CHECK_EQ(interest.skipped, NINST * (NEVENTS / 2));
+	Cwsw_Sme_Sched_Destroy(pSched);
+}
+
+/** Producers and workers all at once, with handlers posting too: no instance ever runs on two
+ *	workers at once, every producer's events reach each instance in order, and nothing is lost.
+ *	Meant to be run under ThreadSanitizer as well (CWSW_SME_TSAN in CMakeLists.txt).
+ */
+static void
+test_stress(void)
+{
+	static uint32_t const workers[] = { 1, 2, 3, 8 };
+	pthread_t producers[NPRODUCERS];
+	tSmeSchedStats stats;
+	uint32_t round, idx;
+	tSmeInstance inst;
+	uint64_t total;
+
+	Setup(NULL);
+	pool.pTbl = stresstbl;
+	pool.capacity = STRESS_INST;
+	pool.count = 0;
+	for(inst = 0; inst < STRESS_INST; ++inst)
+	{
+		CHECK_EQ(Cwsw_Sme_Pool_Add(&pool, SME_INST_STATE(Stress)), inst);
+	}
+
+	for(round = 0; round < sizeof(workers) / sizeof(workers[0]); ++round)
+	{
+		memset(lastseq, 0, sizeof(lastseq));
+		memset(received, 0, sizeof(received));
+		atomic_store(&overlaps, 0);
+		atomic_store(&relayed, 0);
+		pStressSched = Cwsw_Sme_Sched_Create(&pool, workers[round], SZINBOX);
+		CHECK(pStressSched != NULL);
+		if(!pStressSched)	{ return; }
+
+		for(idx = 0; idx < NPRODUCERS; ++idx)
+		{
+			CHECK_EQ(pthread_create(&producers[idx], NULL, StressProducer, (void *)(uintptr_t)idx), 0);
+		}
+		for(idx = 0; idx < NPRODUCERS; ++idx)
+		{
+			(void)pthread_join(producers[idx], NULL);
+		}
+		Cwsw_Sme_Sched_Drain(pStressSched);
+		Cwsw_Sme_Sched_Stats(pStressSched, &stats);
+
+		for(inst = 0, total = 0; inst < STRESS_INST; ++inst)
+		{
+			total += received[inst];
+		}
+		CHECK_EQ(total, NPRODUCERS * STRESS_EVENTS);
+		CHECK_EQ(atomic_load(&overlaps), 0);
+		CHECK_EQ(atomic_load(&outoforder), 0);
+		CHECK_EQ(stats.events, total + atomic_load(&relayed));
+		Cwsw_Sme_Sched_Destroy(pStressSched);
+	}
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(void)
+{
+	RUN_TEST(test_delivery);
+	RUN_TEST(test_interest);
+	RUN_TEST(test_stress);
+	return TEST_RESULT();
+}
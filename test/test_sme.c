@@ -0,0 +1,366 @@
+/** @file
+ *	@brief	Host tests for the SME core: transition lookup and stepping.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "sme_test.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum { evTick = 1, evGo = 2 };
+
+#define TABLE_SIZE(tbl)		((uint32_t)(sizeof(tbl) / sizeof((tbl)[0])))
+
+/** Largest table built by the randomized comparison. */
+#define MAXROWS				(300)
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+/* the stepping tests drive states written as the template writes them; each keeps its phase, and
+ * counts its entry and exit actions, here.
+ */
+static tStateReturnCodes	phase[4];
+static int					entries[4];
+static int					exits[4];
+static int					transitions;
+static uint32_t				lcg = 12345u;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+static uint32_t
+Random(uint32_t range)
+{
+	lcg = (lcg * 1103515245u) + 12345u;
+	return (lcg >> 16) % range;
+}
+
+static void
+ResetStates(void)
+{
+	memset(phase, 0, sizeof(phase));
+	memset(entries, 0, sizeof(entries));
+	memset(exits, 0, sizeof(exits));
+	transitions = 0;
+}
+
+/** Body of every stepping-test state: enter, wait for evGo (or, if `immediate`, announce the exit
+ *	right away), then exit with reason1 = evGo, reason3 = 0.
+ */
+static tStateReturnCodes
+StateBody(int state, bool immediate, ptEvQ_Event pev, uint32_t *pextra)
+{
+	switch(phase[state])
+	{
+	case kStateUninit:
+	default:
+		++entries[state];
+		phase[state] = immediate ? kStateExit : kStateOperational;
+		break;
+
+	case kStateOperational:
+		if(pev->evId == evGo)	{ phase[state] = kStateExit; }
+		break;
+
+	case kStateExit:
+		++exits[state];
+		pev->evId = evGo;
+		pev->evData = 0;
+		*pextra = 0;
+		phase[state] = kStateFinished;
+		break;
+	}
+	return phase[state];
+}
+
+static tStateReturnCodes StateA(ptEvQ_Event pev, uint32_t *pextra)	{ return StateBody(0, false, pev, pextra); }
+static tStateReturnCodes StateB(ptEvQ_Event pev, uint32_t *pextra)	{ return StateBody(1, true, pev, pextra); }
+static tStateReturnCodes StateC(ptEvQ_Event pev, uint32_t *pextra)	{ return StateBody(2, true, pev, pextra); }
+static tStateReturnCodes StateD(ptEvQ_Event pev, uint32_t *pextra)	{ return StateBody(3, false, pev, pextra); }
+
+static void
+CountTransition(tEvQ_Event ev, uint32_t extra)
+{
+	(void)ev;
+	(void)extra;
+	++transitions;
+}
+
+/* for the lookup tests, states are only compared, never called. */
+static tStateReturnCodes S0(ptEvQ_Event pev, uint32_t *pextra)	{ (void)pev; (void)pextra; return kStateOperational; }
+static tStateReturnCodes S1(ptEvQ_Event pev, uint32_t *pextra)	{ (void)pev; (void)pextra; return kStateOperational; }
+static tStateReturnCodes S2(ptEvQ_Event pev, uint32_t *pextra)	{ (void)pev; (void)pextra; return kStateOperational; }
+static tStateReturnCodes S3(ptEvQ_Event pev, uint32_t *pextra)	{ (void)pev; (void)pextra; return kStateOperational; }
+
+static pfStateHandler const	lookupstates[] = { NULL, S0, S1, S2, S3 };
+
+/* the transition function taken is part of what the lookups must agree on. */
+static int lasttransition;
+static void T1(tEvQ_Event ev, uint32_t extra)	{ (void)ev; (void)extra; lasttransition = 1; }
+static void T2(tEvQ_Event ev, uint32_t extra)	{ (void)ev; (void)extra; lasttransition = 2; }
+static void T3(tEvQ_Event ev, uint32_t extra)	{ (void)ev; (void)extra; lasttransition = 3; }
+
+static ptEvQ_EvHandlerFunc const	lookuptransitions[] = { NULL, T1, T2, T3 };
+
+static bool GuardEven(tEvQ_Event ev, uint32_t extra)	{ (void)extra; return (ev.evData % 2) == 0; }
+static bool GuardNever(tEvQ_Event ev, uint32_t extra)	{ (void)ev; (void)extra; return false; }
+
+static pfSmeGuard const	lookupguards[] = { NULL, GuardEven, GuardNever };
+
+static uint8_t const	lookupmasks[] = {
+	kSmeMatch_Default, kSmeMatch_Default, kSmeMatch_Reason1, kSmeMatch_Reason2, kSmeMatch_Reason3,
+	kSmeMatch_Reason1 | kSmeMatch_Reason2, kSmeMatch_Reason1 | kSmeMatch_Reason2 | kSmeMatch_Reason3,
+	kSmeMatch_StateOnly
+};
+
+
+// ============================================================================
+// ----	Tests -----------------------------------------------------------------
+// ============================================================================
+
+static void
+test_last_row_wins(void)
+{
+	tTransitionTable tbl[] = {
+		{ S0, evGo, 0, 0, S1, T1, NULL, kSmeMatch_Default },
+		{ S0, evGo, 0, 0, S2, T2, NULL, kSmeMatch_Default },
+		{ S1, evGo, 0, 0, S3, T3, NULL, kSmeMatch_Default },
+	};
+	tEvQ_Event go = { evGo, 0 };
+	tEvQ_Event tick = { evTick, 0 };
+
+	lasttransition = 0;
+	CHECK(Cwsw_Sme_FindNextState(tbl, TABLE_SIZE(tbl), S0, go, 0) == S2);
+	CHECK_EQ(lasttransition, 2);
+
+	lasttransition = 0;
+	CHECK(Cwsw_Sme_FindNextState(tbl, TABLE_SIZE(tbl), S0, tick, 0) == S0);
+	CHECK_EQ(lasttransition, 0);
+	CHECK(Cwsw_Sme_FindNextState(tbl, TABLE_SIZE(tbl), S0, go, 1) == S0);
+}
+
+static void
+test_masks_and_guards(void)
+{
+	tTransitionTable tbl[] = {
+		{ S0, 0,      0, 0, S1, NULL, NULL,       kSmeMatch_StateOnly },
+		{ S0, evGo,   7, 0, S2, NULL, NULL,       kSmeMatch_Reason1 | kSmeMatch_Reason2 },
+		{ S0, evTick, 0, 0, S3, NULL, GuardEven,  kSmeMatch_Reason1 },
+		{ S0, evTick, 0, 0, S2, NULL, GuardNever, kSmeMatch_Reason1 },
+	};
+	tEvQ_Event ev;
+
+	// reason2 compared, reason3 not.
+	ev.evId = evGo;		ev.evData = 7;
+	CHECK(Cwsw_Sme_FindNextState(tbl, TABLE_SIZE(tbl), S0, ev, 99) == S2);
+	ev.evData = 8;
+	CHECK(Cwsw_Sme_FindNextState(tbl, TABLE_SIZE(tbl), S0, ev, 99) == S1);
+
+	// a failing guard passes the search on to the preceding rows.
+	ev.evId = evTick;	ev.evData = 2;
+	CHECK(Cwsw_Sme_FindNextState(tbl, TABLE_SIZE(tbl), S0, ev, 0) == S3);
+	ev.evData = 3;
+	CHECK(Cwsw_Sme_FindNextState(tbl, TABLE_SIZE(tbl), S0, ev, 0) == S1);
+}
+
+/** The indexed, structure-of-arrays and packed lookups select what the linear search selects. */
+static void
+test_lookups_agree(void)
+{
+	static tTransitionTable		tbl[MAXROWS];
+	static tSmeIndexKey			keys[MAXROWS];
+	static uint32_t				columns[SME_SOA_COLUMNS * MAXROWS];
+	static tSmePackedRow		rows[MAXROWS];
+	static uint16_t				first[TABLE_SIZE(lookupstates) + 1];
+	tSmeTransitionIndex			index;
+	tSmeSoaTable				soa;
+	tSmePackedTable				packed;
+	uint32_t					round, query, row, sztbl;
+
+	for(round = 0; round < 40; ++round)
+	{
+		sztbl = 1 + Random(MAXROWS);
+		for(row = 0; row < sztbl; ++row)
+		{
+			tbl[row].pfCurrent		= lookupstates[1 + Random(4)];
+			tbl[row].reason1		= Random(4);
+			tbl[row].reason2		= Random(3);
+			tbl[row].reason3		= Random(3);
+			tbl[row].pfNext			= lookupstates[1 + Random(4)];
+			tbl[row].pfTransition	= lookuptransitions[Random(TABLE_SIZE(lookuptransitions))];
+			tbl[row].pfGuard		= (Random(4) == 0) ? lookupguards[1 + Random(2)] : NULL;
+			tbl[row].match			= lookupmasks[Random(TABLE_SIZE(lookupmasks))];
+		}
+		CHECK(Cwsw_Sme_CompileTable(&index, tbl, sztbl, keys, sztbl));
+		CHECK(Cwsw_Sme_SoaBuild(&soa, tbl, sztbl, columns, SME_SOA_COLUMNS * sztbl));
+		CHECK(Cwsw_Sme_PackTable(&packed, tbl, sztbl,
+				lookupstates, TABLE_SIZE(lookupstates),
+				lookuptransitions, TABLE_SIZE(lookuptransitions),
+				lookupguards, TABLE_SIZE(lookupguards),
+				rows, first, sztbl));
+
+		for(query = 0; query < 200; ++query)
+		{
+			uint8_t current = (uint8_t)(1 + Random(4));
+			tEvQ_Event ev;
+			uint32_t extra = Random(3);
+			pfStateHandler expect;
+			int expecttransition;
+
+			ev.evId   = (tEvQ_EventID)Random(5);
+			ev.evData = Random(4);
+
+			// now and then, a reason wider than a packed row's, that would match if narrowed.
+			if(Random(8) == 0)	{ ev.evId = (tEvQ_EventID)(ev.evId + 0x10000); }
+			if(Random(8) == 0)	{ ev.evData += 0x10000; }
+			if(Random(8) == 0)	{ extra += 0x10000; }
+
+			lasttransition = 0;
+			expect = Cwsw_Sme_FindNextState(tbl, sztbl, lookupstates[current], ev, extra);
+			expecttransition = lasttransition;
+
+			lasttransition = 0;
+			CHECK(Cwsw_Sme_FindNextStateIndexed(&index, lookupstates[current], ev, extra) == expect);
+			CHECK_EQ(lasttransition, expecttransition);
+
+			lasttransition = 0;
+			CHECK(Cwsw_Sme_FindNextStateSoa(&soa, lookupstates[current], ev, extra) == expect);
+			CHECK_EQ(lasttransition, expecttransition);
+
+			lasttransition = 0;
+			CHECK(lookupstates[Cwsw_Sme_FindNextStatePacked(&packed, current, ev, extra)] == expect);
+			CHECK_EQ(lasttransition, expecttransition);
+		}
+	}
+}
+
+/** Stepwise: exit action, transition, and entry action each take one step. */
+static void
+test_stepwise(void)
+{
+	tTransitionTable tbl[] = {
+		{ StateA, evGo, 0, 0, StateD, CountTransition, NULL, kSmeMatch_Default },
+	};
+	tEvQ_Event tick = { evTick, 0 };
+	tEvQ_Event go = { evGo, 0 };
+	pfStateHandler state = StateA;
+
+	ResetStates();
+	state = Cwsw_Sme__SME(tbl, TABLE_SIZE(tbl), state, tick, 0);		// entry
+	CHECK(state == StateA);
+	CHECK_EQ(entries[0], 1);
+	state = Cwsw_Sme__SME(tbl, TABLE_SIZE(tbl), state, go, 0);		// announces its exit
+	CHECK(state == StateA);
+	CHECK_EQ(exits[0], 0);
+	state = Cwsw_Sme__SME(tbl, TABLE_SIZE(tbl), state, tick, 0);		// exit action, transition
+	CHECK(state == StateD);
+	CHECK_EQ(exits[0], 1);
+	CHECK_EQ(transitions, 1);
+	CHECK_EQ(entries[3], 0);
+	state = Cwsw_Sme__SME(tbl, TABLE_SIZE(tbl), state, tick, 0);		// next state's entry
+	CHECK_EQ(entries[3], 1);
+}
+
+/** Run to completion: the bound stops further transitions, never the selected state's entry. */
+static void
+test_run_to_completion(void)
+{
+	// A waits for evGo; B and C announce their exit as soon as they are entered; D stays.
+	tTransitionTable tbl[] = {
+		{ StateA, evGo, 0, 0, StateB, CountTransition, NULL, kSmeMatch_Default },
+		{ StateB, evGo, 0, 0, StateC, CountTransition, NULL, kSmeMatch_Default },
+		{ StateC, evGo, 0, 0, StateD, CountTransition, NULL, kSmeMatch_Default },
+	};
+	tEvQ_Event tick = { evTick, 0 };
+	tEvQ_Event go = { evGo, 0 };
+	pfStateHandler state;
+	uint32_t bound, taken, calls;
+
+	for(bound = 1; bound <= 4; ++bound)
+	{
+		ResetStates();
+		state = Cwsw_Sme__SMERunToCompletion(tbl, TABLE_SIZE(tbl), StateA, tick, 0, bound, &taken);
+		CHECK(state == StateA);
+		CHECK_EQ(taken, 0);
+
+		state = Cwsw_Sme__SMERunToCompletion(tbl, TABLE_SIZE(tbl), state, go, 0, bound, &taken);
+		CHECK_EQ(taken, (bound < 3) ? bound : 3);
+		CHECK_EQ(transitions, (int)taken);
+		// every state selected has run its entry action within the same call.
+		CHECK_EQ(entries[1], 1);
+		CHECK_EQ(entries[2], (bound >= 2) ? 1 : 0);
+		CHECK_EQ(entries[3], (bound >= 3) ? 1 : 0);
+
+		// whatever the bound cut short finishes on later calls, without entering any state twice.
+		for(calls = 0; (state != StateD) && (calls < 4); ++calls)
+		{
+			state = Cwsw_Sme__SMERunToCompletion(tbl, TABLE_SIZE(tbl), state, tick, 0, bound, NULL);
+		}
+		CHECK(state == StateD);
+		CHECK_EQ(entries[1], 1);
+		CHECK_EQ(entries[2], 1);
+		CHECK_EQ(entries[3], 1);
+		CHECK_EQ(transitions, 3);
+	}
+}
+
+static void
+test_batch(void)
+{
+	tTransitionTable tbl[] = {
+		{ StateA, evGo, 0, 0, StateD, CountTransition, NULL, kSmeMatch_Default },
+	};
+	tEvQ_Event events[] = { { evTick, 0 }, { evGo, 0 }, { evTick, 0 }, { evTick, 0 } };
+	pfStateHandler after[TABLE_SIZE(events)];
+	pfStateHandler state;
+
+	ResetStates();
+	state = Cwsw_Sme__SMEBatch(tbl, TABLE_SIZE(tbl), StateA, events, NULL, TABLE_SIZE(events), after);
+	CHECK(state == StateD);
+	CHECK(after[0] == StateA);
+	CHECK(after[1] == StateA);
+	CHECK(after[2] == StateD);
+	CHECK(after[3] == StateD);
+	CHECK_EQ(entries[3], 1);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(void)
+{
+	RUN_TEST(test_last_row_wins);
+	RUN_TEST(test_masks_and_guards);
+	RUN_TEST(test_lookups_agree);
+	RUN_TEST(test_stepwise);
+	RUN_TEST(test_run_to_completion);
+	RUN_TEST(test_batch);
+	return TEST_RESULT();
+}
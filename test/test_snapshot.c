@@ -0,0 +1,220 @@
+/** @file
+ *	@brief	Host tests for snapshot and restore of SME instance pools.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "sme_test.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme_snapshot.h"
+#include "cwsw_sme_wheel.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/** Instances in each pool. */
+#define NINST				(1000)
+
+/** Slots on each wheel. */
+#define NSLOTS				(64)
+
+/** Clock at the restore, as after a restart well after the save. */
+#define RESTORED_AT			(10000)
+
+/** One pool, with its wheel and every per-instance array. */
+typedef struct sTestPool {
+	pfStateHandler		states[NINST];
+	tStateReturnCodes	phases[NINST];
+	tCwswClockTics		timers[NINST];
+	tEvQ_EventID		evids[NINST];
+	uint32_t			user[NINST];
+	tCwswClockTics		entered[NINST];
+	tSmeInstance		slots[NSLOTS];
+	tSmeInstance		next[NINST];
+	tSmeInstance		prev[NINST];
+	tCwswClockTics		deadlines[NINST];
+	tEvQ_EventID		wheelevids[NINST];
+	tSmePool			pool;
+	tSmeWheel			wheel;
+} tTestPool;
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tTestPool	saved;
+static tTestPool	restored;
+static uint8_t		image[NINST * 32];
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+static tStateReturnCodes A(ptEvQ_Event pev, uint32_t *pextra)	{ (void)pev; (void)pextra; return kStateOperational; }
+static tStateReturnCodes B(ptEvQ_Event pev, uint32_t *pextra)	{ (void)pev; (void)pextra; return kStateOperational; }
+
+static pfStateHandler const	statelist[] = { NULL, A, B };
+
+static pfStateHandler
+Expiry(ptSmePool pPool, tSmeInstance inst, tEvQ_Event ev, uint32_t extra)
+{
+	(void)pPool;
+	(void)inst;
+	(void)ev;
+	(void)extra;
+	return NULL;
+}
+
+static void
+MakePool(tTestPool *p)
+{
+	static tTransitionTable tbl[1];
+	tSmePool pool = {
+		/* .pTbl = */		tbl,
+		/* .szTbl = */		1,
+		/* .pIndex = */		NULL,
+		/* .capacity = */	NINST,
+		/* .count = */		0,
+		/* .pState = */		p->states,
+		/* .pPhase = */		p->phases,
+		/* .pTimer = */		p->timers,
+		/* .pEvId = */		p->evids,
+		/* .pUser = */		(uint8_t *)p->user,
+		/* .szUser = */		sizeof(p->user[0]),
+		/* .maxchain = */	0,
+		/* .pInterest = */	NULL,
+		/* .pHsm = */		NULL,
+		/* .pWheel = */		&p->wheel,
+		/* .pEntered = */	p->entered
+	};
+	tSmeWheel wheel = {
+		/* .pPool = */		&p->pool,
+		/* .pfExpiry = */	Expiry,
+		/* .nSlots = */		NSLOTS,
+		/* .pSlots = */		p->slots,
+		/* .pNext = */		p->next,
+		/* .pPrev = */		p->prev,
+		/* .pDeadline = */	p->deadlines,
+		/* .pEvId = */		p->wheelevids,
+		/* .now = */		0,
+		/* .nArmed = */		0,
+		/* .expiring = */	kSmeInstanceNone
+	};
+
+	memset(p, 0, sizeof(*p));
+	p->pool = pool;
+	p->wheel = wheel;
+	CHECK(Cwsw_Sme_Pool_Init(&p->pool));
+	CHECK(Cwsw_Sme_Wheel_Init(&p->wheel, 0));
+}
+
+
+// ============================================================================
+// ----	Tests -----------------------------------------------------------------
+// ============================================================================
+
+static void
+test_round_trip(void)
+{
+	size_t size;
+	uint32_t inst;
+	int mismatches = 0;
+
+	MakePool(&saved);
+	MakePool(&restored);
+	for(inst = 0; inst < NINST; ++inst)
+	{
+		CHECK_EQ(Cwsw_Sme_Pool_Add(&saved.pool, A), inst);
+		saved.states[inst]	= statelist[inst % 3];
+		saved.phases[inst]	= (tStateReturnCodes)(inst % 4);
+		saved.timers[inst]	= (tCwswClockTics)(1000 + inst);
+		saved.evids[inst]	= (tEvQ_EventID)(inst % 13);
+		saved.user[inst]	= inst * 7;
+		if((inst % 5) == 0)	{ Cwsw_Sme_Wheel_Arm(&saved.wheel, inst, (tCwswClockTics)(1 + (inst % 300)), 9); }
+	}
+
+	size = Cwsw_Sme_Snapshot_Size(&saved.pool);
+	CHECK(size <= sizeof(image));
+	CHECK_EQ(Cwsw_Sme_Snapshot_Save(&saved.pool, statelist, 3, 0, image, size - 1), 0);
+	CHECK_EQ(Cwsw_Sme_Snapshot_Save(&saved.pool, statelist, 3, 0, image, size), size);
+	CHECK(Cwsw_Sme_Snapshot_Restore(&restored.pool, statelist, 3, RESTORED_AT, image, size));
+
+	CHECK_EQ(restored.pool.count, NINST);
+	CHECK_EQ(restored.wheel.nArmed, saved.wheel.nArmed);
+	for(inst = 0; inst < NINST; ++inst)
+	{
+		if(		(restored.states[inst] != saved.states[inst])
+			||	(restored.phases[inst] != saved.phases[inst])
+			||	(restored.timers[inst] != saved.timers[inst] + RESTORED_AT)
+			||	(restored.evids[inst] != saved.evids[inst])
+			||	(restored.user[inst] != saved.user[inst])
+			||	(restored.entered[inst] != RESTORED_AT)
+			||	(Cwsw_Sme_Wheel_IsArmed(&restored.wheel, inst) != ((inst % 5) == 0)))
+		{
+			++mismatches;
+		}
+		else if((inst % 5) == 0)
+		{
+			if(		(restored.deadlines[inst] != saved.deadlines[inst] + RESTORED_AT)
+				||	(restored.wheelevids[inst] != 9))
+			{
+				++mismatches;
+			}
+		}
+	}
+	CHECK_EQ(mismatches, 0);
+}
+
+/** A damaged image, or one read back with the wrong state list, is refused. */
+static void
+test_refused(void)
+{
+	size_t size;
+
+	MakePool(&saved);
+	MakePool(&restored);
+	CHECK_EQ(Cwsw_Sme_Pool_Add(&saved.pool, B), 0);
+	size = Cwsw_Sme_Snapshot_Save(&saved.pool, statelist, 3, 0, image, sizeof(image));
+	CHECK(size > sizeof(tSmeSnapshotHeader));
+
+	CHECK(!Cwsw_Sme_Snapshot_Restore(&restored.pool, statelist, 2, 0, image, size));
+	CHECK(!Cwsw_Sme_Snapshot_Restore(&restored.pool, statelist, 3, 0, image, size - 1));
+	image[size - 1] ^= 1;
+	CHECK(!Cwsw_Sme_Snapshot_Restore(&restored.pool, statelist, 3, 0, image, size));
+	image[size - 1] ^= 1;
+	CHECK(Cwsw_Sme_Snapshot_Restore(&restored.pool, statelist, 3, 0, image, size));
+	CHECK(restored.states[0] == B);
+
+	// a state missing from the list cannot be saved.
+	CHECK_EQ(Cwsw_Sme_Snapshot_Save(&saved.pool, statelist, 2, 0, image, sizeof(image)), 0);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(void)
+{
+	RUN_TEST(test_round_trip);
+	RUN_TEST(test_refused);
+	return TEST_RESULT();
+}
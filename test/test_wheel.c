@@ -0,0 +1,352 @@
+/** @file
+ *	@brief	Host tests for the timing wheel and the tickless driver.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "sme_test.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_sme_wheel.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum { evTimeout = 1, evOther = 2 };
+
+/** Instances in the pool; enough for timeouts to share the wheel's slots. */
+#define NINST				(100)
+
+/** Slots on the wheel; far fewer than the spread of the deadlines. */
+#define NSLOTS				(8)
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static pfStateHandler		states[NINST];
+static tStateReturnCodes	phases[NINST];
+static tCwswClockTics		timers[NINST];
+static tEvQ_EventID			evids[NINST];
+
+static tSmeInstance			slots[NSLOTS];
+static tSmeInstance			next[NINST];
+static tSmeInstance			prev[NINST];
+static tCwswClockTics		deadlines[NINST];
+static tEvQ_EventID			wheelevids[NINST];
+
+static tSmePool				pool;
+static tSmeWheel			wheel;
+
+static int					fired[NINST];
+static tCwswClockTics		firedat[NINST];
+static tEvQ_EventID			firedev[NINST];
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/** Records each timeout. Instance 5 re-arms itself twice; instance 7 cancels instance 8. */
+static pfStateHandler
+Expiry(ptSmePool pPool, tSmeInstance inst, tEvQ_Event ev, uint32_t extra)
+{
+	(void)pPool;
+	(void)extra;
+	++fired[inst];
+	firedat[inst] = wheel.now;
+	firedev[inst] = ev.evId;
+	if((inst == 5) && (fired[inst] < 3))	{ Cwsw_Sme_Wheel_Arm(&wheel, inst, 10, evTimeout); }
+	if(inst == 7)							{ Cwsw_Sme_Wheel_Cancel(&wheel, 8); }
+	return NULL;
+}
+
+/** Records each timeout. Instance 19 cancels 12 and re-arms 13, both due with it; 18 re-arms itself
+ *	once, into its own slot.
+ */
+static pfStateHandler
+SlotExpiry(ptSmePool pPool, tSmeInstance inst, tEvQ_Event ev, uint32_t extra)
+{
+	(void)pPool;
+	(void)ev;
+	(void)extra;
+	++fired[inst];
+	if(inst == 19)
+	{
+		Cwsw_Sme_Wheel_Cancel(&wheel, 12);
+		Cwsw_Sme_Wheel_Arm(&wheel, 13, 3, evTimeout);
+	}
+	if((inst == 18) && (fired[inst] == 1))	{ Cwsw_Sme_Wheel_Arm(&wheel, 18, NSLOTS, evTimeout); }
+	return NULL;
+}
+
+/** Waits for its timeout, then moves on to Expired. */
+static tStateReturnCodes
+Waiting(ptSmeInstCtx pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	switch(SME_INST_PHASE(pctx))
+	{
+	case kStateUninit:
+	default:
+		Cwsw_Sme_Wheel_Arm(pctx->pPool->pWheel, pctx->inst, 4, evTimeout);
+		SME_INST_PHASE(pctx) = kStateOperational;
+		break;
+
+	case kStateOperational:
+		if(pev->evId == evTimeout)	{ SME_INST_PHASE(pctx) = kStateExit; }
+		break;
+
+	case kStateExit:
+		pev->evId = evTimeout;
+		pev->evData = 0;
+		*pextra = 0;
+		SME_INST_PHASE(pctx) = kStateFinished;
+		break;
+	}
+	return SME_INST_PHASE(pctx);
+}
+
+static tStateReturnCodes
+Expired(ptSmeInstCtx pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	(void)pev;
+	(void)pextra;
+	SME_INST_PHASE(pctx) = kStateOperational;
+	return kStateOperational;
+}
+
+static tTransitionTable	tbl[] = {
+	{ SME_INST_STATE(Waiting), evTimeout, 0, 0, SME_INST_STATE(Expired), NULL, NULL, kSmeMatch_Reason1 },
+};
+
+static void
+Setup(pfSmeWheelExpiry pfExpiry, uint32_t maxchain, tCwswClockTics now)
+{
+	tSmePool p = {
+		/* .pTbl = */		tbl,
+		/* .szTbl = */		1,
+		/* .pIndex = */		NULL,
+		/* .capacity = */	NINST,
+		/* .count = */		0,
+		/* .pState = */		states,
+		/* .pPhase = */		phases,
+		/* .pTimer = */		timers,
+		/* .pEvId = */		evids,
+		/* .pUser = */		NULL,
+		/* .szUser = */		0,
+		/* .maxchain = */	maxchain,
+		/* .pInterest = */	NULL,
+		/* .pHsm = */		NULL,
+		/* .pWheel = */		&wheel,
+		/* .pEntered = */	NULL
+	};
+	tSmeWheel w = {
+		/* .pPool = */		&pool,
+		/* .pfExpiry = */	pfExpiry,
+		/* .nSlots = */		NSLOTS,
+		/* .pSlots = */		slots,
+		/* .pNext = */		next,
+		/* .pPrev = */		prev,
+		/* .pDeadline = */	deadlines,
+		/* .pEvId = */		wheelevids,
+		/* .now = */		0,
+		/* .nArmed = */		0,
+		/* .expiring = */	kSmeInstanceNone
+	};
+	uint32_t inst;
+
+	pool = p;
+	wheel = w;
+	CHECK(Cwsw_Sme_Pool_Init(&pool));
+	for(inst = 0; inst < NINST; ++inst)
+	{
+		CHECK_EQ(Cwsw_Sme_Pool_Add(&pool, SME_INST_STATE(Waiting)), inst);
+	}
+	CHECK(Cwsw_Sme_Wheel_Init(&wheel, now));
+	memset(fired, 0, sizeof(fired));
+	memset(firedat, 0, sizeof(firedat));
+	memset(firedev, 0, sizeof(firedev));
+}
+
+
+// ============================================================================
+// ----	Tests -----------------------------------------------------------------
+// ============================================================================
+
+/** Timeouts fire once, at their deadline, however many revolutions away; cancelled ones never. */
+static void
+test_expiry(void)
+{
+	tCwswClockTics now;
+	tCwswClockTics deadline;
+	uint32_t inst;
+
+	Setup(Expiry, 0, 1000);
+	for(inst = 0; inst < NINST; ++inst)
+	{
+		Cwsw_Sme_Wheel_Arm(&wheel, inst, (tCwswClockTics)(inst + 1), evTimeout + (inst % 2));
+	}
+	Cwsw_Sme_Wheel_Cancel(&wheel, 3);
+	CHECK(!Cwsw_Sme_Wheel_IsArmed(&wheel, 3));
+	CHECK(Cwsw_Sme_Wheel_IsArmed(&wheel, 4));
+	CHECK_EQ(Cwsw_Sme_Wheel_TimeLeft(&wheel, 40), 41);
+	CHECK(Cwsw_Sme_Wheel_NextDeadline(&wheel, &deadline));
+	CHECK_EQ(deadline, 1001);
+
+	// one jump: 0 through 7 expire, except 3; 7 cancels 8.
+	CHECK_EQ(Cwsw_Sme_Wheel_Advance(&wheel, 1008), 7);
+	CHECK_EQ(wheel.nArmed, NINST - 9 + 1);		// 5 re-armed itself
+	CHECK_EQ(fired[3], 0);
+	CHECK_EQ(fired[6], 1);
+	CHECK_EQ(firedev[6], evTimeout);
+	CHECK_EQ(firedev[7], evOther);
+	CHECK(Cwsw_Sme_Wheel_NextDeadline(&wheel, &deadline));
+	CHECK_EQ(deadline, 1010);
+
+	for(now = 1009; now <= 1200; ++now)
+	{
+		(void)Cwsw_Sme_Wheel_Advance(&wheel, now);
+	}
+	CHECK_EQ(wheel.nArmed, 0);
+	CHECK(!Cwsw_Sme_Wheel_NextDeadline(&wheel, &deadline));
+	for(inst = 0; inst < NINST; ++inst)
+	{
+		if((inst == 3) || (inst == 8))	{ CHECK_EQ(fired[inst], 0); }
+		else if(inst == 5)				{ CHECK_EQ(fired[inst], 3); }
+		else							{ CHECK_EQ(fired[inst], 1); }
+		if(inst > 8)					{ CHECK_EQ(firedat[inst], 1000 + inst + 1); }
+	}
+
+	// a jump of many revolutions still fires, once.
+	Cwsw_Sme_Wheel_Arm(&wheel, 1, 5, evTimeout);
+	CHECK_EQ(Cwsw_Sme_Wheel_Advance(&wheel, 5000), 1);
+	CHECK_EQ(fired[1], 2);
+}
+
+/** Timeouts due together in one slot are each delivered once, whatever their handlers arm or
+ *	cancel meanwhile; one not yet delivered can still be cancelled or re-armed.
+ */
+static void
+test_shared_slot(void)
+{
+	uint32_t inst;
+
+	Setup(SlotExpiry, 0, 0);
+	for(inst = 10; inst < 20; ++inst)
+	{
+		Cwsw_Sme_Wheel_Arm(&wheel, inst, (tCwswClockTics)(NSLOTS * (inst - 9)), evTimeout);
+	}
+
+	// all ten share slot 0, and are due; delivered from the slot's head, 19 first.
+	CHECK_EQ(Cwsw_Sme_Wheel_Advance(&wheel, NSLOTS * 10), 8);
+	CHECK_EQ(fired[12], 0);
+	CHECK_EQ(fired[13], 0);
+	CHECK_EQ(fired[10], 1);
+	CHECK_EQ(wheel.nArmed, 2);
+	CHECK_EQ(wheel.expiring, kSmeInstanceNone);
+	CHECK(!Cwsw_Sme_Wheel_IsArmed(&wheel, 12));
+	CHECK_EQ(Cwsw_Sme_Wheel_TimeLeft(&wheel, 13), 3);
+
+	CHECK_EQ(Cwsw_Sme_Wheel_Advance(&wheel, NSLOTS * 11), 2);
+	CHECK_EQ(fired[13], 1);
+	CHECK_EQ(fired[18], 2);
+	CHECK_EQ(fired[12], 0);
+	CHECK_EQ(wheel.nArmed, 0);
+}
+
+/** With no delivery function, a timeout steps its instance, which may arm the next timeout. */
+static void
+test_default_delivery(void)
+{
+	tEvQ_Event other = { evOther, 0 };
+	uint32_t inst;
+	uint32_t maxchain;
+
+	for(maxchain = 0; maxchain < 2; ++maxchain)
+	{
+		Setup(NULL, maxchain, 0);
+		Cwsw_Sme__SMEPool(&pool, other, 0);		// entry: arms a timeout for t = 4
+		CHECK_EQ(wheel.nArmed, NINST);
+		CHECK_EQ(Cwsw_Sme_Wheel_Advance(&wheel, 3), 0);
+		CHECK_EQ(Cwsw_Sme_Wheel_Advance(&wheel, 4), NINST);
+		Cwsw_Sme__SMEPool(&pool, other, 0);		// stepwise: the exit action and transition
+		for(inst = 0; inst < NINST; ++inst)
+		{
+			CHECK(states[inst] == SME_INST_STATE(Expired));
+		}
+	}
+}
+
+/** The driving alarm is armed for the earliest deadline, capped by maxsleep, and kicked for events. */
+static void
+test_tickless(void)
+{
+	tCwswSwAlarm alarm = { 20, 20, NULL, 0, kTmrState_Enabled };
+	tSmeTickless drv = { &alarm, &wheel, 0, 0, false, 0, 0 };
+
+	Setup(Expiry, 0, 100);
+	Cwsw_Sme_Wheel_Arm(&wheel, 1, 37, evTimeout);
+	Cwsw_Sme_Wheel_Arm(&wheel, 2, 5, evTimeout);
+	Cwsw_Sme_Wheel_Arm(&wheel, 3, 12, evTimeout);
+
+	Cwsw_Sme_Tickless_Rearm(&drv);
+	CHECK_EQ(alarm.tm, 5);
+	CHECK_EQ(alarm.reloadtm, 0);
+	CHECK_EQ(alarm.tmrstate, kTmrState_Enabled);
+	CHECK(drv.armed);
+	CHECK_EQ(drv.deadline, 105);
+
+	CHECK_EQ(Cwsw_Sme_Tickless_Service(&drv, 105), 1);
+	CHECK_EQ(alarm.tm, 7);
+	CHECK_EQ(Cwsw_Sme_Tickless_Service(&drv, 112), 1);
+	CHECK_EQ(alarm.tm, 25);
+	CHECK_EQ(drv.rearms, 3);
+
+	Cwsw_Sme_Tickless_Kick(&drv);
+	CHECK_EQ(alarm.tm, 0);
+	CHECK_EQ(drv.kicks, 1);
+	CHECK_EQ(Cwsw_Sme_Tickless_Service(&drv, 113), 0);
+	CHECK_EQ(alarm.tm, 24);
+
+	CHECK_EQ(Cwsw_Sme_Tickless_Service(&drv, 137), 1);
+	CHECK(!drv.armed);
+	CHECK_EQ(alarm.tmrstate, kTmrState_Disabled);
+
+	drv.maxsleep = 50;
+	Cwsw_Sme_Tickless_Rearm(&drv);
+	CHECK_EQ(alarm.tm, 50);
+	CHECK_EQ(alarm.tmrstate, kTmrState_Enabled);
+	Cwsw_Sme_Wheel_Arm(&wheel, 4, 500, evTimeout);
+	Cwsw_Sme_Tickless_Rearm(&drv);
+	CHECK_EQ(alarm.tm, 50);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(void)
+{
+	RUN_TEST(test_expiry);
+	RUN_TEST(test_shared_slot);
+	RUN_TEST(test_default_delivery);
+	RUN_TEST(test_tickless);
+	return TEST_RESULT();
+}